@@ -0,0 +1,93 @@
+//
+// Timings for the axis direction specialized toolpath generation. The pass loop is compared with
+// the same loop taking its direction at runtime, the generators are timed on their own.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "toolpath/ToolpathGenerator.h"
+#include "toolpath/ToolpathPasses.h"
+
+namespace {
+constexpr int PASS_COUNT = 1 << 16;
+constexpr int PASS_REPETITIONS = 2000;
+constexpr int TOOLPATH_REPETITIONS = 2000;
+
+// Written to after every run so the compiler cannot drop the work
+volatile double sink;
+
+template<typename Function>
+double millisecondsFor(const int repetitions, Function function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++) {
+        function();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The same closed-form pass loop with the direction only known at runtime, so the comparison
+// isolates the specialization from the loop shape
+void passPositionsRuntime(const double start, const double step, const AxisDirection direction, std::span<double> positions) {
+    const double delta = (direction == AxisDirection::Positive ? -1.0 : 1.0) * step;
+    const int count = static_cast<int>(positions.size());
+    double* out = positions.data();
+    for (int i = 0; i < count; i++) {
+        out[i] = start + delta * (i + 1);
+    }
+}
+
+void benchmarkPassPositions() {
+    std::vector<double> positions(PASS_COUNT);
+    // Read at runtime so the baseline cannot be specialized by the compiler either
+    const AxisDirection direction = sink < 0.0 ? AxisDirection::Negative : AxisDirection::Positive;
+
+    const double runtime = millisecondsFor(PASS_REPETITIONS, [&] {
+        passPositionsRuntime(20.0, 0.5, direction, positions);
+        sink = positions.back();
+    });
+    const double specialized = millisecondsFor(PASS_REPETITIONS, [&] {
+        passPositions<AxisDirection::Positive>(20.0, 0.5, positions);
+        sink = positions.back();
+    });
+
+    std::printf("pass positions, %d passes x %d\n", PASS_COUNT, PASS_REPETITIONS);
+    std::printf("  runtime direction      %8.2f ms\n", runtime);
+    std::printf("  specialized direction  %8.2f ms (%.1fx)\n", specialized, runtime / specialized);
+}
+
+void benchmarkToolpaths() {
+    OperationConfiguration operation;
+    operation.outerDistance = 40.0;
+    operation.innerDistance = 10.0;
+    operation.axialStartPosition = 0.0;
+    operation.axialEndPosition = -60.0;
+    operation.stepover = 0.25;
+    operation.cutDepthPerPass = 0.25;
+
+    std::printf("toolpath generation x %d\n", TOOLPATH_REPETITIONS);
+    for (const OperationType type : {OperationType::Facing, OperationType::Turning, OperationType::Parting}) {
+        operation.operationType = type;
+        for (const AxisDirection direction : {AxisDirection::Positive, AxisDirection::Negative}) {
+            MachineConfig machineConfig;
+            machineConfig.zAxisDirection = direction;
+            machineConfig.xAxisDirection = direction;
+
+            size_t moves = 0;
+            const double elapsed = millisecondsFor(TOOLPATH_REPETITIONS, [&] {
+                moves = ToolpathGenerator::generateToolpath(operation, machineConfig).size();
+            });
+            std::printf("  %-8s %-8s %6zu moves %8.2f ms\n", toString(type).c_str(),
+                        direction == AxisDirection::Positive ? "positive" : "negative", moves, elapsed);
+        }
+    }
+}
+}
+
+int main() {
+    benchmarkPassPositions();
+    benchmarkToolpaths();
+    return 0;
+}
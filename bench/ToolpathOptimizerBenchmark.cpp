@@ -0,0 +1,34 @@
+//
+// Timings for merging long collinear runs, which should grow linearly with the run length.
+//
+
+#include <chrono>
+#include <cstdio>
+
+#include "toolpath/ToolpathOptimizer.h"
+
+namespace {
+double millisecondsToMerge(const size_t lines) {
+    TToolpathSequence sequence;
+    sequence.reserve(lines);
+    for (size_t i = 0; i < lines; i++) {
+        sequence.addLine(TPoint(10.0, -0.01 * static_cast<double>(i)), TPoint(10.0, -0.01 * static_cast<double>(i + 1)));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const ToolpathOptimizerResult result = optimizeToolpath(sequence);
+    const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (result.sequence.size() != 1) {
+        std::printf("  run of %zu lines was not merged into one\n", lines);
+    }
+    return elapsed;
+}
+}
+
+int main() {
+    std::printf("collinear run merging\n");
+    for (const size_t lines : {5000, 20000, 80000, 320000}) {
+        const double elapsed = millisecondsToMerge(lines);
+        std::printf("  %7zu lines %8.2f ms %6.1f ns/line\n", lines, elapsed, elapsed * 1e6 / static_cast<double>(lines));
+    }
+    return 0;
+}
@@ -46,6 +46,18 @@ class Fanuc0TPostProcessor(PostProcessor):
             self.current_x = x
             self.current_z = z
 
+    def arc_move(self, end, center, clockwise, feedrate):
+        """Generate circular interpolation, center given as absolute position"""
+        start_x = self.current_x if self.current_x is not None else end.x
+        start_z = self.current_z if self.current_z is not None else end.z
+        i = center.x - start_x
+        k = center.z - start_z
+        code = "G02" if clockwise else "G03"
+
+        self.add_line(f"{code}X{end.x:.3f}Z{end.z:.3f}I{i:.3f}K{k:.3f}F{feedrate:.2f}")
+        self.current_x = end.x
+        self.current_z = end.z
+
     def spindle_on(self, rpm, direction=1):
         """Start spindle with speed and rotation direction"""
         if not self.spindle_running:
@@ -63,6 +63,18 @@ class GenericISOPostProcessor(PostProcessor):
         if coords:
             self.add_line(f"G01 {' '.join(coords)} F{feedrate:.3f}")
 
+    def arc_move(self, end, center, clockwise, feedrate):
+        """Generate circular interpolation, center given as absolute position"""
+        start_x = self.current_x if self.current_x is not None else end.x
+        start_z = self.current_z if self.current_z is not None else end.z
+        i = center.x - start_x
+        k = center.z - start_z
+        code = "G02" if clockwise else "G03"
+
+        self.add_line(f"{code} X{end.x:.4f} Z{end.z:.4f} I{i:.4f} K{k:.4f} F{feedrate:.3f}")
+        self.current_x = end.x
+        self.current_z = end.z
+
     def spindle_on(self, rpm, direction=1):
         """Start spindle with speed and rotation direction"""
         # Clamp RPM to machine limits
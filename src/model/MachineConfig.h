@@ -29,6 +29,11 @@ struct MachineConfig {
     // Feed rates
     double rapidFeedRate = 200.0;        // Rapid move feed rate in mm/min
     double retractFeedRate = 150.0;      // Retract move feed rate in mm/min
+
+    // Kinematics, used for cycle time estimation
+    double axisAcceleration = 500.0;      // Axis acceleration in mm/s^2
+    double spindleAcceleration = 1000.0;  // Spindle speed change rate in RPM/s
+    double toolChangeTime = 5.0;          // Time for a tool change in s
     
     // Display Settings
     int displayPrecision = 3;             // Number of decimal places for coordinates
@@ -39,8 +44,8 @@ struct MachineConfig {
 
     // Chuck Position (fixed on left side - no configuration needed)
     
-    // JSON serialization
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(MachineConfig,
+    // JSON serialization, fields missing from older configurations keep their defaults
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(MachineConfig,
         zAxisDirection,
         xAxisDirection,
         maxSpindleSpeed,
@@ -51,6 +56,9 @@ struct MachineConfig {
         minClearanceDistance,
         rapidFeedRate,
         retractFeedRate,
+        axisAcceleration,
+        spindleAcceleration,
+        toolChangeTime,
         displayPrecision,
         postprocessorScriptPath,
         postprocessorClassName
@@ -0,0 +1,197 @@
+//
+// Circular arc segment, stored by its endpoints and bulge.
+//
+
+#include "Arc.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Line.h"
+
+namespace {
+
+struct ArcParameters {
+    double cx;
+    double cy;
+    double radius;
+    double startAngle;
+    double sweep;
+};
+
+ArcParameters arcParameters(const double x1, const double y1, const double x2, const double y2, const double bulge) {
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    const double chord = std::sqrt(dx * dx + dy * dy);
+    // Offset of the center from the chord midpoint along the chord's left normal
+    const double offset = (1.0 - bulge * bulge) / (4.0 * bulge);
+    const double cx = (x1 + x2) / 2.0 - dy * offset;
+    const double cy = (y1 + y2) / 2.0 + dx * offset;
+    return {
+        cx,
+        cy,
+        chord * (1.0 + bulge * bulge) / (4.0 * std::abs(bulge)),
+        std::atan2(y1 - cy, x1 - cx),
+        4.0 * std::atan(bulge)
+    };
+}
+
+// Whether the direction angle lies within the swept range of the arc
+bool withinSweep(const ArcParameters& arc, const double angle) {
+    double t = arc.sweep >= 0.0 ? angle - arc.startAngle : arc.startAngle - angle;
+    t = std::fmod(t, 2.0 * M_PI);
+    if (t < 0.0) {
+        t += 2.0 * M_PI;
+    }
+    return t <= std::abs(arc.sweep);
+}
+
+}
+
+Arc Arc::fromCenter(const Point& center, const double radius, const double startAngle, const double endAngle) {
+    double sweep = std::fmod(endAngle - startAngle, 2.0 * M_PI);
+    if (sweep <= 0.0) {
+        sweep += 2.0 * M_PI;
+    }
+    return {
+        Point(center.x + radius * std::cos(startAngle), center.y + radius * std::sin(startAngle)),
+        Point(center.x + radius * std::cos(endAngle), center.y + radius * std::sin(endAngle)),
+        std::tan(sweep / 4.0)
+    };
+}
+
+Point Arc::center() const {
+    if (bulge == 0.0) {
+        return {(p1.x + p2.x) / 2.0, (p1.y + p2.y) / 2.0};
+    }
+    const ArcParameters arc = arcParameters(p1.x, p1.y, p2.x, p2.y, bulge);
+    return {arc.cx, arc.cy};
+}
+
+double Arc::radius() const {
+    if (bulge == 0.0) {
+        return INFINITY;
+    }
+    return arcParameters(p1.x, p1.y, p2.x, p2.y, bulge).radius;
+}
+
+double Arc::sweep() const {
+    return 4.0 * std::atan(bulge);
+}
+
+double Arc::distance(const Point& point) const {
+    return arcDistance(p1.x, p1.y, p2.x, p2.y, bulge, point);
+}
+
+BoundingBox Arc::bounds() const {
+    return arcBounds(p1.x, p1.y, p2.x, p2.y, bulge);
+}
+
+std::vector<Point> Arc::tessellate(const double tolerance) const {
+    if (bulge == 0.0 || p1 == p2) {
+        return {p1, p2};
+    }
+    const ArcParameters arc = arcParameters(p1.x, p1.y, p2.x, p2.y, bulge);
+    // Largest angle step whose chord stays within tolerance of the arc
+    const double step = tolerance < arc.radius ? 2.0 * std::acos(1.0 - tolerance / arc.radius) : M_PI_2;
+    const auto count = static_cast<size_t>(std::max(1.0, std::ceil(std::abs(arc.sweep) / std::min(step, M_PI_2))));
+
+    std::vector<Point> points;
+    points.reserve(count + 1);
+    points.push_back(p1);
+    for (size_t i = 1; i < count; i++) {
+        const double angle = arc.startAngle + arc.sweep * static_cast<double>(i) / static_cast<double>(count);
+        points.emplace_back(arc.cx + arc.radius * std::cos(angle), arc.cy + arc.radius * std::sin(angle));
+    }
+    points.push_back(p2);
+    return points;
+}
+
+bool Arc::operator==(const Segment& other) const {
+    if (auto* otherArc = dynamic_cast<const Arc*>(&other)) {
+        return (p1 == otherArc->p1 && p2 == otherArc->p2 && bulge == otherArc->bulge) ||
+               (p1 == otherArc->p2 && p2 == otherArc->p1 && bulge == -otherArc->bulge);
+    }
+    return false;
+}
+
+bool Arc::operator!=(const Segment& other) const {
+    return !(*this == other);
+}
+
+std::unique_ptr<Segment> Arc::transform(const std::vector<Transform>& transformations) {
+    Transform composed;
+    for (const auto& transformation : transformations) {
+        composed = transformation * composed;
+    }
+    // Mirroring reverses the turning direction
+    const double newBulge = composed.determinant() < 0.0 ? -bulge : bulge;
+    return std::make_unique<Arc>(composed.apply(p1), composed.apply(p2), newBulge);
+}
+
+std::unique_ptr<Segment> Arc::clone() const {
+    return std::make_unique<Arc>(*this);
+}
+
+double arcDistance(const double x1, const double y1, const double x2, const double y2, const double bulge, const Point& point) {
+    if (bulge == 0.0 || (x1 == x2 && y1 == y2)) {
+        return lineDistance(x1, y1, x2, y2, point);
+    }
+    const ArcParameters arc = arcParameters(x1, y1, x2, y2, bulge);
+    const double px = point.x - arc.cx;
+    const double py = point.y - arc.cy;
+    if (withinSweep(arc, std::atan2(py, px))) {
+        return std::abs(std::sqrt(px * px + py * py) - arc.radius);
+    }
+    return std::min(std::hypot(point.x - x1, point.y - y1), std::hypot(point.x - x2, point.y - y2));
+}
+
+BoundingBox arcBounds(const double x1, const double y1, const double x2, const double y2, const double bulge) {
+    BoundingBox box = BoundingBox::of(Point(x1, y1), Point(x2, y2));
+    if (bulge == 0.0 || (x1 == x2 && y1 == y2)) {
+        return box;
+    }
+    const ArcParameters arc = arcParameters(x1, y1, x2, y2, bulge);
+    // Extend by the axis extremes the arc passes through
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        const double angle = quadrant * M_PI_2;
+        if (withinSweep(arc, angle)) {
+            box.expand(Point(arc.cx + arc.radius * std::cos(angle), arc.cy + arc.radius * std::sin(angle)));
+        }
+    }
+    return box;
+}
+
+bool arcIntersects(const double x1, const double y1, const double x2, const double y2, const double bulge, const BoundingBox& box) {
+    if (bulge == 0.0 || (x1 == x2 && y1 == y2)) {
+        return lineIntersects(x1, y1, x2, y2, box);
+    }
+    if (!arcBounds(x1, y1, x2, y2, bulge).intersects(box)) {
+        return false;
+    }
+    if (box.contains(Point(x1, y1)) || box.contains(Point(x2, y2))) {
+        return true;
+    }
+    // Both endpoints are outside, so the arc has to cross one of the box edges
+    const ArcParameters arc = arcParameters(x1, y1, x2, y2, bulge);
+    const auto crosses = [&](const double fixed, const double low, const double high, const bool vertical) {
+        const double d = fixed - (vertical ? arc.cx : arc.cy);
+        if (std::abs(d) > arc.radius) {
+            return false;
+        }
+        const double h = std::sqrt(arc.radius * arc.radius - d * d);
+        const double center = vertical ? arc.cy : arc.cx;
+        for (const double t : {center - h, center + h}) {
+            if (t < low || t > high) {
+                continue;
+            }
+            const double angle = vertical ? std::atan2(t - arc.cy, d) : std::atan2(d, t - arc.cx);
+            if (withinSweep(arc, angle)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    return crosses(box.minX, box.minY, box.maxY, true) || crosses(box.maxX, box.minY, box.maxY, true) ||
+           crosses(box.minY, box.minX, box.maxX, false) || crosses(box.maxY, box.minX, box.maxX, false);
+}
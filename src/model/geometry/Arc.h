@@ -0,0 +1,62 @@
+//
+// Circular arc segment, stored by its endpoints and bulge.
+//
+
+#ifndef TURNLAB_ARC_H
+#define TURNLAB_ARC_H
+
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "BoundingBox.h"
+#include "Point.h"
+#include "Segment.h"
+#include "Transform.h"
+
+// An arc from p1 to p2. The bulge is tan(sweep / 4), as in DXF polylines:
+// positive bulges turn counter-clockwise, negative ones clockwise, and a bulge
+// of +-1 is a half circle. Full circles need to be split into two arcs.
+class Arc : public Segment {
+public:
+    Point p1;
+    Point p2;
+    double bulge = 0.0;
+
+    Arc() = default;
+    Arc(const Point& start, const Point& end, double bulge) : p1(start), p2(end), bulge(bulge) {}
+    ~Arc() override = default;
+
+    // Counter-clockwise arc between two angles in radians
+    static Arc fromCenter(const Point& center, double radius, double startAngle, double endAngle);
+
+    Point center() const;
+    double radius() const;
+    // Signed sweep angle in radians, positive counter-clockwise
+    double sweep() const;
+    bool isClockwise() const { return bulge < 0.0; }
+
+    double distance(const Point& point) const override;
+    BoundingBox bounds() const;
+
+    // Points along the arc, including both endpoints, with a chord error of at most tolerance
+    std::vector<Point> tessellate(double tolerance) const;
+
+    bool operator==(const Segment& other) const override;
+    bool operator!=(const Segment& other) const;
+    std::unique_ptr<Segment> transform(const std::vector<Transform>& transformations) override;
+    std::unique_ptr<Segment> clone() const override;
+
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(Arc, p1, p2, bulge)
+};
+
+// Distance from point to the arc (x1, y1) -> (x2, y2) with the given bulge
+double arcDistance(double x1, double y1, double x2, double y2, double bulge, const Point& point);
+
+// Tight bounding box of the arc (x1, y1) -> (x2, y2) with the given bulge
+BoundingBox arcBounds(double x1, double y1, double x2, double y2, double bulge);
+
+// Whether the arc (x1, y1) -> (x2, y2) with the given bulge crosses or lies inside the box
+bool arcIntersects(double x1, double y1, double x2, double y2, double bulge, const BoundingBox& box);
+
+#endif //TURNLAB_ARC_H
@@ -0,0 +1,58 @@
+//
+// Axis-aligned bounding box used by the spatial indices.
+//
+
+#ifndef TURNLAB_BOUNDINGBOX_H
+#define TURNLAB_BOUNDINGBOX_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Point.h"
+
+struct BoundingBox {
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = std::numeric_limits<double>::infinity();
+    double maxX = -std::numeric_limits<double>::infinity();
+    double maxY = -std::numeric_limits<double>::infinity();
+
+    BoundingBox() = default;
+    BoundingBox(double minX, double minY, double maxX, double maxY) : minX(minX), minY(minY), maxX(maxX), maxY(maxY) {}
+
+    static BoundingBox of(const Point& p1, const Point& p2) {
+        return {std::min(p1.x, p2.x), std::min(p1.y, p2.y), std::max(p1.x, p2.x), std::max(p1.y, p2.y)};
+    }
+
+    bool empty() const { return minX > maxX || minY > maxY; }
+
+    void expand(const BoundingBox& other) {
+        minX = std::min(minX, other.minX);
+        minY = std::min(minY, other.minY);
+        maxX = std::max(maxX, other.maxX);
+        maxY = std::max(maxY, other.maxY);
+    }
+
+    void expand(const Point& p) {
+        expand(BoundingBox(p.x, p.y, p.x, p.y));
+    }
+
+    bool intersects(const BoundingBox& other) const {
+        return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+
+    bool contains(const Point& p) const {
+        return p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY;
+    }
+
+    // Euclidean distance from p to the box, 0 if p is inside
+    double distance(const Point& p) const {
+        const double dx = std::max({minX - p.x, 0.0, p.x - maxX});
+        const double dy = std::max({minY - p.y, 0.0, p.y - maxY});
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    Point center() const { return {(minX + maxX) / 2.0, (minY + maxY) / 2.0}; }
+};
+
+#endif //TURNLAB_BOUNDINGBOX_H
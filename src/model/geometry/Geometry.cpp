@@ -2,41 +2,24 @@
 // Created by gawain on 9/11/25.
 //
 
-#include <memory>
-
 #include "Geometry.h"
+#include "Arc.h"
 #include "Line.h"
+#include "TransformKernel.h"
 
-Geometry::Geometry(std::vector<std::unique_ptr<Segment>>& segments) {
-    this->segments = std::move(segments);
-}
-
-Geometry::Geometry(const Geometry& other) {
-    segments.reserve(other.segments.size());
-    for (const auto& seg : other.segments) {
-        if (seg) {
-            segments.push_back(seg->clone());
-        }
-    }
-}
-
-Geometry& Geometry::operator=(const Geometry& other) {
-    if (this != &other) {
-        segments.clear();
-        segments.reserve(other.segments.size());
-        for (const auto& seg : other.segments) {
-            if (seg) {
-                segments.push_back(seg->clone());
-            }
-        }
-    }
-    return *this;
-}
+Geometry::Geometry(SegmentStore segments) : segments(std::move(segments)) {}
 
-Geometry Geometry::transform(std::vector<Transform> transformations) {
+Geometry Geometry::transform(const Transform& transformation) const {
     Geometry transformedGeometry;
-    for (const auto& segment : segments) {
-        transformedGeometry.segments.push_back(segment->transform(transformations));
+    transformedGeometry.segments = segments;
+    SegmentStore& s = transformedGeometry.segments;
+    transformPoints(transformation, s.x1.data(), s.y1.data(), s.size());
+    transformPoints(transformation, s.x2.data(), s.y2.data(), s.size());
+    if (transformation.determinant() < 0.0) {
+        // Mirroring reverses the turning direction of arcs
+        for (double& bulge : s.bulge) {
+            bulge = -bulge;
+        }
     }
     return transformedGeometry;
 }
@@ -45,17 +28,25 @@ Geometry Geometry::transform(std::vector<Transform> transformations) {
 void to_json(nlohmann::json& j, const Geometry& g) {
     j = nlohmann::json::array();
 
-    for (const auto& segment : g.segments) {
-        if (!segment) continue;
-
+    for (const SegmentView segment : g.segments) {
         // Check the type of segment and serialize accordingly
-        if (auto* line = dynamic_cast<const Line*>(segment.get())) {
-            nlohmann::json segmentJson;
-            segmentJson["type"] = "Line";
-            segmentJson["data"] = *line;
-            j.push_back(segmentJson);
+        switch (segment.kind()) {
+            case SegmentKind::Line: {
+                nlohmann::json segmentJson;
+                segmentJson["type"] = "Line";
+                segmentJson["data"] = Line(segment.start(), segment.end());
+                j.push_back(segmentJson);
+                break;
+            }
+            case SegmentKind::Arc: {
+                nlohmann::json segmentJson;
+                segmentJson["type"] = "Arc";
+                segmentJson["data"] = Arc(segment.start(), segment.end(), segment.bulge());
+                j.push_back(segmentJson);
+                break;
+            }
+            // Add more segment types here as they're implemented
         }
-        // Add more segment types here as they're implemented
     }
 }
 
@@ -64,15 +55,16 @@ void from_json(const nlohmann::json& j, Geometry& g) {
 
     if (!j.is_array()) return;
 
+    g.segments.reserve(j.size());
     for (const auto& segmentJson : j) {
         if (!segmentJson.contains("type") || !segmentJson.contains("data")) continue;
 
         std::string type = segmentJson["type"];
 
         if (type == "Line") {
-            auto line = std::make_unique<Line>();
-            *line = segmentJson["data"].get<Line>();
-            g.segments.push_back(std::move(line));
+            g.segments.addLine(segmentJson["data"].get<Line>());
+        } else if (type == "Arc") {
+            g.segments.addArc(segmentJson["data"].get<Arc>());
         }
         // Add more segment types here as they're implemented
     }
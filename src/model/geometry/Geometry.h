@@ -8,29 +8,21 @@
 #include <vector>
 #include <nlohmann/json.hpp>
 
-#include "Segment.h"
+#include "SegmentStore.h"
 #include "Transform.h"
 
 class Geometry {
 public:
     Geometry() = default;
-    explicit Geometry(std::vector<std::unique_ptr<Segment>>& segments);
-    Geometry(const Geometry& other);
-    virtual ~Geometry() = default;
+    explicit Geometry(SegmentStore segments);
 
-    Geometry& operator=(const Geometry& other);
+    Geometry transform(const Transform& transformation) const;
 
-    // Make movable
-    Geometry(Geometry&&) = default;
-    Geometry& operator=(Geometry&&) = default;
-
-    Geometry transform(std::vector<Transform> transformations);
-
-    std::vector<std::unique_ptr<Segment>> segments;
+    SegmentStore segments;
 };
 
 // Custom JSON serialization for Geometry
 void to_json(nlohmann::json& j, const Geometry& g);
 void from_json(const nlohmann::json& j, Geometry& g);
 
-#endif //TURNLAB_GEOMETRY_H
\ No newline at end of file
+#endif //TURNLAB_GEOMETRY_H
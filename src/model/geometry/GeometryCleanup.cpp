@@ -0,0 +1,246 @@
+//
+// Import-time cleanup of duplicate, overlapping and degenerate segments.
+//
+
+#include "GeometryCleanup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "PointGrid.h"
+
+namespace {
+
+struct PairHash {
+    size_t operator()(const std::pair<int64_t, int64_t>& key) const {
+        return static_cast<size_t>(key.first) * 73856093u ^ static_cast<size_t>(key.second) * 19349663u;
+    }
+};
+
+double distance(const Point& a, const Point& b) {
+    return std::hypot(b.x - a.x, b.y - a.y);
+}
+
+// Point halfway along a segment, distinguishes arcs sharing their endpoints
+Point midpoint(const SegmentStore& segments, const size_t index) {
+    const double dx = segments.x2[index] - segments.x1[index];
+    const double dy = segments.y2[index] - segments.y1[index];
+    // The sagitta is bulge * chord / 2, positive bulges lie to the right of the chord
+    const double sagitta = segments.bulge[index] / 2.0;
+    return {(segments.x1[index] + segments.x2[index]) / 2.0 + sagitta * dy,
+            (segments.y1[index] + segments.y2[index]) / 2.0 - sagitta * dx};
+}
+
+// Infinite line through a segment, with its direction folded into [0, pi)
+struct Carrier {
+    double angle;
+    // Signed distance of the line from the origin
+    double offset;
+};
+
+Carrier carrierOf(const SegmentStore& segments, const size_t index) {
+    double angle = std::atan2(segments.y2[index] - segments.y1[index], segments.x2[index] - segments.x1[index]);
+    if (angle < 0.0) {
+        angle += M_PI;
+    }
+    if (angle >= M_PI) {
+        angle -= M_PI;
+    }
+    return {angle, -std::sin(angle) * segments.x1[index] + std::cos(angle) * segments.y1[index]};
+}
+
+class DisjointSets {
+public:
+    explicit DisjointSets(const size_t size) : parent(size) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    uint32_t find(uint32_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    // Keeps the smaller index as root
+    void unite(const uint32_t a, const uint32_t b) {
+        const uint32_t ra = find(a);
+        const uint32_t rb = find(b);
+        if (ra != rb) {
+            parent[std::max(ra, rb)] = std::min(ra, rb);
+        }
+    }
+
+private:
+    std::vector<uint32_t> parent;
+};
+
+}
+
+CleanupResult cleanupSegments(const SegmentStore& segments, const CleanupOptions& options) {
+    CleanupResult result;
+    const double tolerance = options.tolerance;
+    const size_t count = segments.size();
+
+    std::vector<bool> removed(count, false);
+    // Merged lines replacing the first segment of their group
+    std::vector<std::optional<std::pair<Point, Point>>> replacements(count);
+
+    // Duplicates: same welded endpoints, in either direction, and the same midpoint
+    const WeldedVertices welded = weldEndpoints(segments, tolerance);
+    std::unordered_map<std::pair<int64_t, int64_t>, std::vector<uint32_t>, PairHash> byEndpoints;
+    byEndpoints.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t a = welded.startVertex[i];
+        const uint32_t b = welded.endVertex[i];
+        if (a == b) {
+            removed[i] = true;
+            result.degenerateRemoved++;
+            continue;
+        }
+
+        std::vector<uint32_t>& candidates = byEndpoints[{std::min(a, b), std::max(a, b)}];
+        const Point mid = midpoint(segments, i);
+        const bool duplicate = std::ranges::any_of(candidates, [&](const uint32_t j) {
+            return segments.kinds[j] == segments.kinds[i] && distance(midpoint(segments, j), mid) <= tolerance;
+        });
+        if (duplicate) {
+            removed[i] = true;
+            result.duplicatesRemoved++;
+        } else {
+            candidates.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    // Collinear lines: hash by direction and offset, then verify candidates in neighbouring buckets
+    const double offsetStep = std::max(tolerance, 1e-12);
+    const auto angleBuckets = static_cast<int64_t>(std::ceil(M_PI / COLLINEAR_ANGLE_STEP));
+    const auto keyOf = [&](const double angle, const double offset) {
+        return std::pair<int64_t, int64_t>{static_cast<int64_t>(std::floor(angle / COLLINEAR_ANGLE_STEP)),
+                                           static_cast<int64_t>(std::floor(offset / offsetStep))};
+    };
+
+    std::vector<uint32_t> lines;
+    std::vector<Carrier> carriers(count);
+    std::unordered_map<std::pair<int64_t, int64_t>, std::vector<uint32_t>, PairHash> byCarrier;
+    for (size_t i = 0; i < count; i++) {
+        if (removed[i] || segments.kinds[i] != SegmentKind::Line) {
+            continue;
+        }
+        lines.push_back(static_cast<uint32_t>(i));
+        carriers[i] = carrierOf(segments, i);
+        byCarrier[keyOf(carriers[i].angle, carriers[i].offset)].push_back(static_cast<uint32_t>(i));
+    }
+
+    // Both endpoints of line j within tolerance of the carrier of line i
+    const auto collinear = [&](const uint32_t i, const uint32_t j) {
+        return std::abs(-std::sin(carriers[i].angle) * (segments.x1[j] - segments.x1[i]) +
+                        std::cos(carriers[i].angle) * (segments.y1[j] - segments.y1[i])) <= tolerance &&
+               std::abs(-std::sin(carriers[i].angle) * (segments.x2[j] - segments.x1[i]) +
+                        std::cos(carriers[i].angle) * (segments.y2[j] - segments.y1[i])) <= tolerance;
+    };
+
+    DisjointSets groups(count);
+    for (const uint32_t i : lines) {
+        const auto [angleKey, offsetKey] = keyOf(carriers[i].angle, carriers[i].offset);
+        for (int64_t da = -1; da <= 1; da++) {
+            int64_t a = angleKey + da;
+            double offset = carriers[i].offset;
+            // Directions near 0 and near pi are parallel, with opposite offsets
+            if (a < 0 || a >= angleBuckets) {
+                a = (a + angleBuckets) % angleBuckets;
+                offset = -offset;
+            }
+            const int64_t o = keyOf(0.0, offset).second;
+            for (int64_t d = -1; d <= 1; d++) {
+                const auto it = byCarrier.find({a, o + d});
+                if (it == byCarrier.end()) {
+                    continue;
+                }
+                for (const uint32_t j : it->second) {
+                    if (j > i && collinear(i, j)) {
+                        groups.unite(i, j);
+                    }
+                }
+            }
+        }
+    }
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> members;
+    for (const uint32_t i : lines) {
+        members[groups.find(i)].push_back(i);
+    }
+
+    struct Interval {
+        double start;
+        double end;
+        uint32_t first;
+        size_t count;
+    };
+    for (auto& [root, group] : members) {
+        if (group.size() < 2) {
+            continue;
+        }
+
+        // Project onto the direction of the group's first line
+        const Point origin = segments.startPoint(root);
+        const double length = distance(segments.startPoint(root), segments.endPoint(root));
+        const double ux = (segments.x2[root] - segments.x1[root]) / length;
+        const double uy = (segments.y2[root] - segments.y1[root]) / length;
+        std::vector<Interval> intervals;
+        intervals.reserve(group.size());
+        for (const uint32_t i : group) {
+            const double t1 = (segments.x1[i] - origin.x) * ux + (segments.y1[i] - origin.y) * uy;
+            const double t2 = (segments.x2[i] - origin.x) * ux + (segments.y2[i] - origin.y) * uy;
+            intervals.push_back({std::min(t1, t2), std::max(t1, t2), i, 1});
+        }
+        std::ranges::sort(intervals, {}, &Interval::start);
+
+        const auto emit = [&](const Interval& interval) {
+            if (interval.count > 1) {
+                replacements[interval.first] = std::pair{Point(origin.x + ux * interval.start, origin.y + uy * interval.start),
+                                                         Point(origin.x + ux * interval.end, origin.y + uy * interval.end)};
+            }
+        };
+        Interval current = intervals.front();
+        for (size_t k = 1; k < intervals.size(); k++) {
+            const Interval& next = intervals[k];
+            // Lines merely touching end to end stay separate
+            if (next.start < current.end - tolerance) {
+                current.end = std::max(current.end, next.end);
+                removed[std::max(current.first, next.first)] = true;
+                current.first = std::min(current.first, next.first);
+                current.count++;
+                result.overlapsMerged++;
+            } else {
+                emit(current);
+                current = next;
+            }
+        }
+        emit(current);
+    }
+
+    result.segments.reserve(count - result.removed());
+    for (size_t i = 0; i < count; i++) {
+        if (removed[i]) {
+            continue;
+        }
+        if (replacements[i]) {
+            result.segments.addLine(replacements[i]->first, replacements[i]->second);
+        } else {
+            result.segments.append(segments, i);
+        }
+    }
+
+    spdlog::debug("Cleanup removed {} duplicate, {} overlapping and {} degenerate segments",
+                  result.duplicatesRemoved, result.overlapsMerged, result.degenerateRemoved);
+    return result;
+}
@@ -0,0 +1,37 @@
+//
+// Import-time cleanup of duplicate, overlapping and degenerate segments.
+//
+
+#ifndef TURNLAB_GEOMETRYCLEANUP_H
+#define TURNLAB_GEOMETRYCLEANUP_H
+
+#include <cstddef>
+
+#include "SegmentStore.h"
+
+// Width of the direction buckets used to find collinear lines, in radians
+#define COLLINEAR_ANGLE_STEP 1e-3
+
+struct CleanupOptions {
+    // Endpoints closer than this are considered equal, lines closer than this to each other collinear
+    double tolerance = 1e-6;
+};
+
+struct CleanupResult {
+    SegmentStore segments;
+    // Segments with the same endpoints and shape as an earlier one, in either direction
+    size_t duplicatesRemoved = 0;
+    // Collinear lines absorbed by joining overlapping fragments into single lines
+    size_t overlapsMerged = 0;
+    // Segments whose endpoints coincide
+    size_t degenerateRemoved = 0;
+
+    size_t removed() const { return duplicatesRemoved + overlapsMerged + degenerateRemoved; }
+};
+
+// Removes exact and near duplicates and joins collinear overlapping lines, using spatial hashes
+// over endpoints and over line direction and offset. Segments that only touch end to end are
+// kept as they are, so profile vertices survive. The remaining segments keep their order.
+CleanupResult cleanupSegments(const SegmentStore& segments, const CleanupOptions& options = {});
+
+#endif //TURNLAB_GEOMETRYCLEANUP_H
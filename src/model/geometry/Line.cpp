@@ -2,10 +2,11 @@
 // Created by gawain on 9/9/25.
 //
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include "Line.h"
-#include "Vector.h"
 
 bool Line::operator==(const Segment &other) const {
     if (auto *otherLine = dynamic_cast<const Line*>(&other)) {
@@ -30,19 +31,55 @@ bool Line::operator!=(const Segment &other) const {
 }
 
 double Line::distance(const Point &point) const {
-    Vector b = Vector(p1, p2);
-    if (b.norm() == 0) {
-        return Vector(p1, point).norm();
+    return lineDistance(p1.x, p1.y, p2.x, p2.y, point);
+}
+
+double lineDistance(const double x1, const double y1, const double x2, const double y2, const Point &point) {
+    const double bx = x2 - x1;
+    const double by = y2 - y1;
+    const double qx = point.x - x1;
+    const double qy = point.y - y1;
+    const double bb = bx * bx + by * by;
+    if (bb == 0) {
+        return std::sqrt(qx * qx + qy * qy);
     }
-    Vector q = Vector(p1, point);
-    double qp = q.dot(b) / b.dot(b);
+    const double qp = (qx * bx + qy * by) / bb;
     if (qp > 1) {
-        return Vector(p2, point).norm();
+        const double rx = point.x - x2;
+        const double ry = point.y - y2;
+        return std::sqrt(rx * rx + ry * ry);
     } else if (qp < 0) {
-        return Vector(p1, point).norm();
+        return std::sqrt(qx * qx + qy * qy);
     } else {
-        return std::abs((q[1] * b[0] - q[0] * b[1]) / b.norm());
+        return std::abs((qy * bx - qx * by) / std::sqrt(bb));
+    }
+}
+
+bool lineIntersects(const double x1, const double y1, const double x2, const double y2, const BoundingBox& box) {
+    if (!BoundingBox::of(Point(x1, y1), Point(x2, y2)).intersects(box)) {
+        return false;
+    }
+    // Liang-Barsky clipping of the line against the box
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    const double p[] = {-dx, dx, -dy, dy};
+    const double q[] = {x1 - box.minX, box.maxX - x1, y1 - box.minY, box.maxY - y1};
+    double t0 = 0.0;
+    double t1 = 1.0;
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0) return false;
+        } else {
+            const double t = q[i] / p[i];
+            if (p[i] < 0.0) {
+                t0 = std::max(t0, t);
+            } else {
+                t1 = std::min(t1, t);
+            }
+            if (t0 > t1) return false;
+        }
     }
+    return true;
 }
 
 bool Line::isVertical() const {
@@ -9,6 +9,7 @@
 #include <vector>
 #include <nlohmann/json.hpp>
 
+#include "BoundingBox.h"
 #include "Point.h"
 #include "Segment.h"
 #include "Transform.h"
@@ -36,4 +37,10 @@ public:
     NLOHMANN_DEFINE_TYPE_INTRUSIVE(Line, p1, p2)
 };
 
+// Distance from point to the line segment (x1, y1) -> (x2, y2)
+double lineDistance(double x1, double y1, double x2, double y2, const Point& point);
+
+// Whether the line segment (x1, y1) -> (x2, y2) crosses or lies inside the box
+bool lineIntersects(double x1, double y1, double x2, double y2, const BoundingBox& box);
+
 #endif //TURNLAB_LINE_H
\ No newline at end of file
@@ -34,11 +34,11 @@ Point Point::operator-(const Point& other) const {
 }
 
 Point Point::transform(const std::vector<Transform> &transformations) {
-    Point transformedPoint = *this;
+    Transform composed;
     for (const auto& transform : transformations) {
-        transformedPoint = transformedPoint.apply(transform);
+        composed = transform * composed;
     }
-    return transformedPoint;
+    return composed.apply(*this);
 }
 
 Point Point::apply(const Transform &transformation) {
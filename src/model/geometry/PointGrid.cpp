@@ -0,0 +1,123 @@
+//
+// Uniform spatial hash over points, used for vertex welding and point picking.
+//
+
+#include "PointGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BoundingBox.h"
+
+// Smallest cell size used, avoids degenerate grids for exact welding or coincident points
+static constexpr double MIN_CELL_SIZE = 1e-9;
+
+PointGrid::PointGrid(const double cellSize) : cellSize(std::max(cellSize, MIN_CELL_SIZE)) {}
+
+PointGrid::PointGrid(const std::vector<Point>& points) {
+    BoundingBox box;
+    for (const auto& p : points) {
+        box.expand(p);
+    }
+    if (!points.empty()) {
+        // Aim for roughly one point per cell
+        const double extent = std::max(box.maxX - box.minX, box.maxY - box.minY);
+        cellSize = std::max(extent / std::sqrt(static_cast<double>(points.size())), MIN_CELL_SIZE);
+    }
+    this->points.reserve(points.size());
+    cells.reserve(points.size());
+    for (const auto& p : points) {
+        add(p);
+    }
+}
+
+PointGrid::CellKey PointGrid::cellOf(const Point& point) const {
+    return {static_cast<int64_t>(std::floor(point.x / cellSize)), static_cast<int64_t>(std::floor(point.y / cellSize))};
+}
+
+size_t PointGrid::add(const Point& point) {
+    const auto index = static_cast<uint32_t>(points.size());
+    points.push_back(point);
+    cells[cellOf(point)].push_back(index);
+    return index;
+}
+
+std::optional<size_t> PointGrid::nearest(const Point& point, const double maxDistance) const {
+    std::optional<size_t> best;
+    double bestDistance = maxDistance;
+
+    const auto visit = [&](const std::vector<uint32_t>& cell) {
+        for (const uint32_t index : cell) {
+            const double dx = points[index].x - point.x;
+            const double dy = points[index].y - point.y;
+            const double distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < bestDistance || (distance == bestDistance && (!best || index < *best))) {
+                bestDistance = distance;
+                best = index;
+            }
+        }
+    };
+
+    const double reachCells = std::ceil(maxDistance / cellSize);
+    const double scannedCells = (2.0 * reachCells + 1.0) * (2.0 * reachCells + 1.0);
+    if (!(scannedCells <= static_cast<double>(cells.size()))) {
+        // Search radius covers more cells than are occupied, walk the occupied ones instead
+        for (const auto& [key, cell] : cells) {
+            visit(cell);
+        }
+        return best;
+    }
+
+    const CellKey center = cellOf(point);
+    const auto reach = static_cast<int64_t>(reachCells);
+    for (int64_t x = center.x - reach; x <= center.x + reach; x++) {
+        for (int64_t y = center.y - reach; y <= center.y + reach; y++) {
+            if (const auto it = cells.find({x, y}); it != cells.end()) {
+                visit(it->second);
+            }
+        }
+    }
+    return best;
+}
+
+std::vector<size_t> PointGrid::within(const Point& point, const double radius) const {
+    std::vector<size_t> result;
+    const CellKey center = cellOf(point);
+    const auto reach = static_cast<int64_t>(std::ceil(radius / cellSize));
+    for (int64_t x = center.x - reach; x <= center.x + reach; x++) {
+        for (int64_t y = center.y - reach; y <= center.y + reach; y++) {
+            const auto it = cells.find({x, y});
+            if (it == cells.end()) {
+                continue;
+            }
+            for (const uint32_t index : it->second) {
+                if (std::hypot(points[index].x - point.x, points[index].y - point.y) <= radius) {
+                    result.push_back(index);
+                }
+            }
+        }
+    }
+    std::ranges::sort(result);
+    return result;
+}
+
+WeldedVertices weldEndpoints(const SegmentStore& segments, const double tolerance) {
+    WeldedVertices result;
+    result.startVertex.reserve(segments.size());
+    result.endVertex.reserve(segments.size());
+
+    PointGrid grid(tolerance);
+    const auto weld = [&](const Point& p) {
+        if (const auto existing = grid.nearest(p, tolerance)) {
+            return static_cast<uint32_t>(*existing);
+        }
+        return static_cast<uint32_t>(grid.add(p));
+    };
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        result.startVertex.push_back(weld(segments.startPoint(i)));
+        result.endVertex.push_back(weld(segments.endPoint(i)));
+    }
+    result.points = grid.getPoints();
+    return result;
+}
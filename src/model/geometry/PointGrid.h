@@ -0,0 +1,65 @@
+//
+// Uniform spatial hash over points, used for vertex welding and point picking.
+//
+
+#ifndef TURNLAB_POINTGRID_H
+#define TURNLAB_POINTGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Point.h"
+#include "SegmentStore.h"
+
+class PointGrid {
+public:
+    PointGrid() = default;
+    explicit PointGrid(double cellSize);
+    // Builds a grid over points with a cell size derived from their spread
+    explicit PointGrid(const std::vector<Point>& points);
+
+    size_t add(const Point& point);
+
+    // Index of the point closest to point, if it is within maxDistance
+    std::optional<size_t> nearest(const Point& point, double maxDistance) const;
+    // Indices of all points within radius of point, in ascending order
+    std::vector<size_t> within(const Point& point, double radius) const;
+
+    const std::vector<Point>& getPoints() const { return points; }
+    size_t size() const { return points.size(); }
+    double getCellSize() const { return cellSize; }
+
+private:
+    struct CellKey {
+        int64_t x;
+        int64_t y;
+        bool operator==(const CellKey& other) const = default;
+    };
+
+    struct CellKeyHash {
+        size_t operator()(const CellKey& key) const {
+            return static_cast<size_t>(key.x) * 73856093u ^ static_cast<size_t>(key.y) * 19349663u;
+        }
+    };
+
+    double cellSize = 1.0;
+    std::vector<Point> points;
+    std::unordered_map<CellKey, std::vector<uint32_t>, CellKeyHash> cells;
+
+    CellKey cellOf(const Point& point) const;
+};
+
+// Endpoints of a SegmentStore merged into shared vertices
+struct WeldedVertices {
+    std::vector<Point> points;
+    std::vector<uint32_t> startVertex;  // vertex index of each segment's start point
+    std::vector<uint32_t> endVertex;    // vertex index of each segment's end point
+};
+
+// Merge segment endpoints closer than tolerance into single vertices, in first-seen order
+WeldedVertices weldEndpoints(const SegmentStore& segments, double tolerance);
+
+#endif //TURNLAB_POINTGRID_H
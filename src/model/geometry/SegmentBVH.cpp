@@ -0,0 +1,134 @@
+//
+// Static bounding-volume hierarchy over the segments of a SegmentStore.
+//
+
+#include "SegmentBVH.h"
+
+#include <algorithm>
+
+SegmentBVH::SegmentBVH(const SegmentStore& segments) : segments(&segments) {
+    const size_t count = segments.size();
+    if (count == 0) {
+        return;
+    }
+
+    boxes.reserve(count);
+    std::vector<Point> centers;
+    centers.reserve(count);
+    order.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        boxes.push_back(segments.bounds(i));
+        centers.push_back(boxes.back().center());
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    nodes.reserve(2 * (count / LEAF_SIZE + 1));
+    build(0, static_cast<uint32_t>(count), centers);
+}
+
+uint32_t SegmentBVH::build(const uint32_t begin, const uint32_t end, const std::vector<Point>& centers) {
+    const auto nodeIndex = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    BoundingBox box;
+    BoundingBox centerBox;
+    for (uint32_t i = begin; i < end; i++) {
+        box.expand(boxes[order[i]]);
+        centerBox.expand(centers[order[i]]);
+    }
+    nodes[nodeIndex].box = box;
+
+    if (end - begin <= LEAF_SIZE) {
+        nodes[nodeIndex].start = begin;
+        nodes[nodeIndex].count = end - begin;
+        return nodeIndex;
+    }
+
+    // Median split along the axis with the largest spread of segment centers
+    const bool splitX = centerBox.maxX - centerBox.minX >= centerBox.maxY - centerBox.minY;
+    const uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](const uint32_t a, const uint32_t b) {
+        return splitX ? centers[a].x < centers[b].x : centers[a].y < centers[b].y;
+    });
+
+    build(begin, mid, centers);
+    const uint32_t right = build(mid, end, centers);
+    nodes[nodeIndex].right = right;
+    return nodeIndex;
+}
+
+std::optional<size_t> SegmentBVH::nearest(const Point& point, const double maxDistance) const {
+    if (nodes.empty()) {
+        return std::nullopt;
+    }
+
+    std::optional<size_t> best;
+    double bestDistance = maxDistance;
+
+    std::vector<uint32_t> stack = {0};
+    while (!stack.empty()) {
+        const uint32_t current = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[current];
+
+        if (node.box.distance(point) > bestDistance) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.start; i < node.start + node.count; i++) {
+                const uint32_t segment = order[i];
+                if (boxes[segment].distance(point) > bestDistance) {
+                    continue;
+                }
+                const double distance = segments->distance(segment, point);
+                if (distance < bestDistance || (distance == bestDistance && (!best || segment < *best))) {
+                    bestDistance = distance;
+                    best = segment;
+                }
+            }
+            continue;
+        }
+
+        // Visit the closer child first so the search bound shrinks quickly
+        const uint32_t left = current + 1;
+        const uint32_t right = node.right;
+        if (nodes[left].box.distance(point) <= nodes[right].box.distance(point)) {
+            stack.push_back(right);
+            stack.push_back(left);
+        } else {
+            stack.push_back(left);
+            stack.push_back(right);
+        }
+    }
+    return best;
+}
+
+std::vector<size_t> SegmentBVH::query(const BoundingBox& rect) const {
+    std::vector<size_t> result;
+    if (nodes.empty()) {
+        return result;
+    }
+
+    std::vector<uint32_t> stack = {0};
+    while (!stack.empty()) {
+        const uint32_t current = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[current];
+        if (!node.box.intersects(rect)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.start; i < node.start + node.count; i++) {
+                if (segments->intersects(order[i], rect)) {
+                    result.push_back(order[i]);
+                }
+            }
+        } else {
+            stack.push_back(node.right);
+            stack.push_back(current + 1);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
@@ -0,0 +1,51 @@
+//
+// Static bounding-volume hierarchy over the segments of a SegmentStore.
+//
+
+#ifndef TURNLAB_SEGMENTBVH_H
+#define TURNLAB_SEGMENTBVH_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "BoundingBox.h"
+#include "Point.h"
+#include "SegmentStore.h"
+
+class SegmentBVH {
+public:
+    SegmentBVH() = default;
+    // The store is referenced, not copied, and must outlive the tree
+    explicit SegmentBVH(const SegmentStore& segments);
+
+    // Index of the segment closest to point, if it is within maxDistance
+    std::optional<size_t> nearest(const Point& point, double maxDistance) const;
+
+    // Indices of all segments that cross or lie inside the rectangle, in ascending order
+    std::vector<size_t> query(const BoundingBox& rect) const;
+
+    size_t size() const { return order.size(); }
+    bool empty() const { return order.empty(); }
+
+private:
+    static constexpr uint32_t LEAF_SIZE = 4;
+
+    // Leaves reference order[start, start + count). Internal nodes have count == 0,
+    // their left child directly follows them and the right child is stored explicitly.
+    struct Node {
+        BoundingBox box;
+        uint32_t start = 0;
+        uint32_t count = 0;
+        uint32_t right = 0;
+    };
+
+    const SegmentStore* segments = nullptr;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> order;
+    std::vector<BoundingBox> boxes;
+
+    uint32_t build(uint32_t begin, uint32_t end, const std::vector<Point>& centers);
+};
+
+#endif //TURNLAB_SEGMENTBVH_H
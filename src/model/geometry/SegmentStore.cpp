@@ -0,0 +1,180 @@
+//
+// Contiguous structure-of-arrays storage for geometry segments.
+//
+
+#include "SegmentStore.h"
+
+#include <cmath>
+#include <stdexcept>
+
+SegmentKind SegmentView::kind() const {
+    return store->kinds[idx];
+}
+
+Point SegmentView::start() const {
+    return store->startPoint(idx);
+}
+
+Point SegmentView::end() const {
+    return store->endPoint(idx);
+}
+
+double SegmentView::bulge() const {
+    return store->bulge[idx];
+}
+
+double SegmentView::distance(const Point& point) const {
+    return store->distance(idx, point);
+}
+
+std::optional<Line> SegmentView::asLine() const {
+    if (kind() != SegmentKind::Line) {
+        return std::nullopt;
+    }
+    return Line(start(), end());
+}
+
+std::optional<Arc> SegmentView::asArc() const {
+    if (kind() != SegmentKind::Arc) {
+        return std::nullopt;
+    }
+    return Arc(start(), end(), bulge());
+}
+
+std::unique_ptr<Segment> SegmentView::toSegment() const {
+    switch (kind()) {
+        case SegmentKind::Line:
+            return std::make_unique<Line>(start(), end());
+        case SegmentKind::Arc:
+            return std::make_unique<Arc>(start(), end(), bulge());
+    }
+    return nullptr;
+}
+
+bool SegmentView::operator==(const Segment& other) const {
+    const auto segment = toSegment();
+    return segment && *segment == other;
+}
+
+void SegmentStore::reserve(const size_t count) {
+    kinds.reserve(count);
+    x1.reserve(count);
+    y1.reserve(count);
+    x2.reserve(count);
+    y2.reserve(count);
+    bulge.reserve(count);
+}
+
+void SegmentStore::clear() {
+    kinds.clear();
+    x1.clear();
+    y1.clear();
+    x2.clear();
+    y2.clear();
+    bulge.clear();
+}
+
+size_t SegmentStore::addLine(const double sx, const double sy, const double ex, const double ey) {
+    kinds.push_back(SegmentKind::Line);
+    x1.push_back(sx);
+    y1.push_back(sy);
+    x2.push_back(ex);
+    y2.push_back(ey);
+    bulge.push_back(0.0);
+    return kinds.size() - 1;
+}
+
+size_t SegmentStore::addLine(const Point& start, const Point& end) {
+    return addLine(start.x, start.y, end.x, end.y);
+}
+
+size_t SegmentStore::addLine(const Line& line) {
+    return addLine(line.p1, line.p2);
+}
+
+size_t SegmentStore::addArc(const double sx, const double sy, const double ex, const double ey, const double b) {
+    kinds.push_back(SegmentKind::Arc);
+    x1.push_back(sx);
+    y1.push_back(sy);
+    x2.push_back(ex);
+    y2.push_back(ey);
+    bulge.push_back(b);
+    return kinds.size() - 1;
+}
+
+size_t SegmentStore::addArc(const Arc& arc) {
+    return addArc(arc.p1.x, arc.p1.y, arc.p2.x, arc.p2.y, arc.bulge);
+}
+
+size_t SegmentStore::add(const Segment& segment) {
+    if (const auto* line = dynamic_cast<const Line*>(&segment)) {
+        return addLine(*line);
+    }
+    if (const auto* arc = dynamic_cast<const Arc*>(&segment)) {
+        return addArc(*arc);
+    }
+    throw std::invalid_argument("Unsupported segment type");
+}
+
+size_t SegmentStore::addPolyline(const std::vector<Point>& vertices, const std::vector<double>& bulges, const bool closed) {
+    if (vertices.size() < 2) {
+        return 0;
+    }
+    const size_t before = size();
+    const size_t count = closed ? vertices.size() : vertices.size() - 1;
+    reserve(before + count);
+    for (size_t i = 0; i < count; i++) {
+        const Point& start = vertices[i];
+        const Point& end = vertices[(i + 1) % vertices.size()];
+        if (start == end) {
+            continue;
+        }
+        const double b = i < bulges.size() ? bulges[i] : 0.0;
+        if (b == 0.0) {
+            addLine(start, end);
+        } else {
+            addArc(start.x, start.y, end.x, end.y, b);
+        }
+    }
+    return size() - before;
+}
+
+size_t SegmentStore::append(const SegmentStore& other, const size_t index) {
+    kinds.push_back(other.kinds[index]);
+    x1.push_back(other.x1[index]);
+    y1.push_back(other.y1[index]);
+    x2.push_back(other.x2[index]);
+    y2.push_back(other.y2[index]);
+    bulge.push_back(other.bulge[index]);
+    return kinds.size() - 1;
+}
+
+double SegmentStore::distance(const size_t index, const Point& point) const {
+    switch (kinds[index]) {
+        case SegmentKind::Line:
+            return lineDistance(x1[index], y1[index], x2[index], y2[index], point);
+        case SegmentKind::Arc:
+            return arcDistance(x1[index], y1[index], x2[index], y2[index], bulge[index], point);
+    }
+    return INFINITY;
+}
+
+BoundingBox SegmentStore::bounds(const size_t index) const {
+    switch (kinds[index]) {
+        case SegmentKind::Line:
+            break;
+        case SegmentKind::Arc:
+            return arcBounds(x1[index], y1[index], x2[index], y2[index], bulge[index]);
+    }
+    return BoundingBox::of(startPoint(index), endPoint(index));
+}
+
+bool SegmentStore::intersects(const size_t index, const BoundingBox& box) const {
+    switch (kinds[index]) {
+        case SegmentKind::Line:
+            return lineIntersects(x1[index], y1[index], x2[index], y2[index], box);
+        case SegmentKind::Arc:
+            return arcIntersects(x1[index], y1[index], x2[index], y2[index], bulge[index], box);
+    }
+    return false;
+}
@@ -0,0 +1,114 @@
+//
+// Contiguous structure-of-arrays storage for geometry segments.
+//
+
+#ifndef TURNLAB_SEGMENTSTORE_H
+#define TURNLAB_SEGMENTSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Arc.h"
+#include "BoundingBox.h"
+#include "Line.h"
+#include "Point.h"
+#include "Segment.h"
+
+enum class SegmentKind : uint8_t {
+    Line,
+    Arc
+};
+
+class SegmentStore;
+
+// Cheap read-only handle to a single segment of a SegmentStore
+class SegmentView {
+public:
+    SegmentView() = default;
+    SegmentView(const SegmentStore& store, size_t index) : store(&store), idx(index) {}
+
+    size_t index() const { return idx; }
+    SegmentKind kind() const;
+    Point start() const;
+    Point end() const;
+
+    double bulge() const;
+    double distance(const Point& point) const;
+
+    std::optional<Line> asLine() const;
+    std::optional<Arc> asArc() const;
+    std::unique_ptr<Segment> toSegment() const;
+
+    bool operator==(const Segment& other) const;
+
+private:
+    const SegmentStore* store = nullptr;
+    size_t idx = 0;
+};
+
+class SegmentStore {
+public:
+    // Endpoint coordinates, one entry per segment
+    std::vector<SegmentKind> kinds;
+    std::vector<double> x1;
+    std::vector<double> y1;
+    std::vector<double> x2;
+    std::vector<double> y2;
+    // Arc bulge, tan(sweep / 4), 0 for lines
+    std::vector<double> bulge;
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = SegmentView;
+        using difference_type = std::ptrdiff_t;
+        using reference = SegmentView;
+        using pointer = void;
+
+        Iterator() = default;
+        Iterator(const SegmentStore& store, size_t index) : store(&store), index(index) {}
+
+        SegmentView operator*() const { return {*store, index}; }
+        Iterator& operator++() { ++index; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++index; return tmp; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+
+    private:
+        const SegmentStore* store = nullptr;
+        size_t index = 0;
+    };
+
+    size_t size() const { return kinds.size(); }
+    bool empty() const { return kinds.empty(); }
+    void reserve(size_t count);
+    void clear();
+
+    size_t addLine(double sx, double sy, double ex, double ey);
+    size_t addLine(const Point& start, const Point& end);
+    size_t addLine(const Line& line);
+    size_t addArc(double sx, double sy, double ex, double ey, double bulge);
+    size_t addArc(const Arc& arc);
+    size_t add(const Segment& segment);
+    // Adds the lines and arcs of a polyline, bulges[i] belonging to the segment starting at vertex i.
+    // Zero length segments are skipped. Returns the number of segments added.
+    size_t addPolyline(const std::vector<Point>& vertices, const std::vector<double>& bulges, bool closed);
+    // Copies segment index of another store
+    size_t append(const SegmentStore& other, size_t index);
+
+    Point startPoint(size_t index) const { return {x1[index], y1[index]}; }
+    Point endPoint(size_t index) const { return {x2[index], y2[index]}; }
+    double distance(size_t index, const Point& point) const;
+    BoundingBox bounds(size_t index) const;
+    bool intersects(size_t index, const BoundingBox& box) const;
+
+    SegmentView operator[](size_t index) const { return {*this, index}; }
+    Iterator begin() const { return {*this, 0}; }
+    Iterator end() const { return {*this, size()}; }
+};
+
+#endif //TURNLAB_SEGMENTSTORE_H
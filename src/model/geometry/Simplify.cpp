@@ -0,0 +1,121 @@
+//
+// Douglas-Peucker simplification of dense line profiles.
+//
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+#include "Line.h"
+#include "Topology.h"
+
+std::vector<size_t> douglasPeucker(const std::vector<Point>& points, const double tolerance) {
+    if (points.size() < 3) {
+        std::vector<size_t> all(points.size());
+        for (size_t i = 0; i < all.size(); i++) {
+            all[i] = i;
+        }
+        return all;
+    }
+
+    std::vector<bool> keep(points.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+
+    // Explicit stack, profiles can have many thousands of points
+    std::vector<std::pair<size_t, size_t>> ranges = {{0, points.size() - 1}};
+    while (!ranges.empty()) {
+        const auto [first, last] = ranges.back();
+        ranges.pop_back();
+
+        double maxDistance = -1.0;
+        size_t farthest = first;
+        const Point& a = points[first];
+        const Point& b = points[last];
+        for (size_t i = first + 1; i < last; i++) {
+            const double distance = lineDistance(a.x, a.y, b.x, b.y, points[i]);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                farthest = i;
+            }
+        }
+        if (maxDistance > tolerance) {
+            keep[farthest] = true;
+            if (farthest - first > 1) {
+                ranges.emplace_back(first, farthest);
+            }
+            if (last - farthest > 1) {
+                ranges.emplace_back(farthest, last);
+            }
+        }
+    }
+
+    std::vector<size_t> kept;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (keep[i]) {
+            kept.push_back(i);
+        }
+    }
+    return kept;
+}
+
+SimplifyResult simplifySegments(const SegmentStore& segments, const double tolerance) {
+    SimplifyResult result;
+    result.segmentsBefore = segments.size();
+    result.segments.reserve(segments.size());
+
+    const Topology topology = buildTopology(segments);
+
+    // Vertices another segment ends on must stay where they are
+    std::vector<bool> fixed(topology.vertices.size(), false);
+    for (const TJunction& junction : topology.junctions) {
+        fixed[junction.vertex] = true;
+    }
+
+    std::vector<bool> emitted(segments.size(), false);
+    std::vector<Point> run;
+    const auto flushRun = [&] {
+        if (run.size() >= 2) {
+            const std::vector<size_t> kept = douglasPeucker(run, tolerance);
+            for (size_t k = 0; k + 1 < kept.size(); k++) {
+                result.segments.addLine(run[kept[k]], run[kept[k + 1]]);
+            }
+        }
+        run.clear();
+    };
+
+    for (const Chain& chain : topology.chains) {
+        for (size_t k = 0; k < chain.elements.size(); k++) {
+            const ChainElement& element = chain.elements[k];
+            emitted[element.segment] = true;
+            if (segments.kinds[element.segment] != SegmentKind::Line) {
+                flushRun();
+                result.segments.append(segments, element.segment);
+                continue;
+            }
+
+            const Point start = topology.start(element, segments);
+            if (run.empty()) {
+                run.push_back(start);
+            } else if (fixed[chain.vertices[k]]) {
+                // Split the run at the fixed vertex
+                flushRun();
+                run.push_back(start);
+            }
+            run.push_back(topology.end(element, segments));
+        }
+        flushRun();
+    }
+
+    // Degenerate segments aren't part of any chain
+    for (size_t i = 0; i < segments.size(); i++) {
+        if (!emitted[i]) {
+            result.segments.append(segments, i);
+        }
+    }
+
+    spdlog::debug("Simplified {} segments to {}", result.segmentsBefore, result.segments.size());
+    return result;
+}
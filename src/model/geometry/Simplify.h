@@ -0,0 +1,33 @@
+//
+// Douglas-Peucker simplification of dense line profiles.
+//
+
+#ifndef TURNLAB_SIMPLIFY_H
+#define TURNLAB_SIMPLIFY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Point.h"
+#include "SegmentStore.h"
+
+// Tolerance applied while importing DXF files, in drawing units. Small enough to only drop
+// points that are redundant at machining resolution.
+#define DEFAULT_SIMPLIFY_TOLERANCE 0.001
+
+struct SimplifyResult {
+    SegmentStore segments;
+    size_t segmentsBefore = 0;
+
+    size_t removed() const { return segmentsBefore - segments.size(); }
+};
+
+// Indices of the points kept by Douglas-Peucker, always including the first and last point
+std::vector<size_t> douglasPeucker(const std::vector<Point>& points, double tolerance);
+
+// Replaces runs of consecutive lines within each chain of the profile by fewer lines deviating at
+// most tolerance from them. Arcs, chain ends and branch vertices are kept, segments are emitted
+// chain by chain in chain direction.
+SimplifyResult simplifySegments(const SegmentStore& segments, double tolerance);
+
+#endif //TURNLAB_SIMPLIFY_H
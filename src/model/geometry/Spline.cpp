@@ -0,0 +1,106 @@
+//
+// Rational B-spline curve with adaptive tessellation into line segments.
+//
+
+#include "Spline.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "Line.h"
+
+// Subdivision depth limit, bounds the output to 2^MAX_DEPTH points per knot span
+static constexpr int MAX_DEPTH = 16;
+
+Spline::Spline(const int degree, std::vector<Point> controlPoints, std::vector<double> knots, std::vector<double> weights)
+    : degree(degree), controlPoints(std::move(controlPoints)), knots(std::move(knots)), weights(std::move(weights)) {
+    if (this->degree < 1 || this->controlPoints.size() <= static_cast<size_t>(this->degree)) {
+        throw std::invalid_argument("Spline needs more control points than its degree");
+    }
+    if (this->knots.size() != this->controlPoints.size() + this->degree + 1) {
+        throw std::invalid_argument("Spline knot count must be control points + degree + 1");
+    }
+    if (!std::ranges::is_sorted(this->knots)) {
+        throw std::invalid_argument("Spline knots must be non-decreasing");
+    }
+    if (!this->weights.empty() && this->weights.size() != this->controlPoints.size()) {
+        throw std::invalid_argument("Spline needs one weight per control point");
+    }
+}
+
+double Spline::startParameter() const {
+    return knots[degree];
+}
+
+double Spline::endParameter() const {
+    return knots[controlPoints.size()];
+}
+
+Point Spline::evaluate(double t) const {
+    const auto n = static_cast<int>(controlPoints.size());
+    t = std::clamp(t, startParameter(), endParameter());
+
+    // Knot span k with knots[k] <= t < knots[k + 1], restricted to the valid range
+    const auto upper = std::upper_bound(knots.begin() + degree, knots.begin() + n, t);
+    const int k = std::clamp(static_cast<int>(upper - knots.begin()) - 1, degree, n - 1);
+
+    // De Boor's algorithm in homogeneous coordinates
+    std::vector<std::array<double, 3>> d(degree + 1);
+    for (int j = 0; j <= degree; j++) {
+        const Point& p = controlPoints[j + k - degree];
+        const double w = weights.empty() ? 1.0 : weights[j + k - degree];
+        d[j] = {p.x * w, p.y * w, w};
+    }
+    for (int r = 1; r <= degree; r++) {
+        for (int j = degree; j >= r; j--) {
+            const double left = knots[j + k - degree];
+            const double right = knots[j + 1 + k - r];
+            const double alpha = right == left ? 0.0 : (t - left) / (right - left);
+            for (int c = 0; c < 3; c++) {
+                d[j][c] = (1.0 - alpha) * d[j - 1][c] + alpha * d[j][c];
+            }
+        }
+    }
+    return {d[degree][0] / d[degree][2], d[degree][1] / d[degree][2]};
+}
+
+std::vector<Point> Spline::tessellate(const double tolerance) const {
+    std::vector<Point> points;
+    const double start = startParameter();
+    const double end = endParameter();
+
+    // Each knot span is a single polynomial piece, start by splitting at the knots
+    std::vector<double> breaks = {start};
+    for (const double knot : knots) {
+        if (knot > breaks.back() && knot < end) {
+            breaks.push_back(knot);
+        }
+    }
+    breaks.push_back(end);
+
+    points.push_back(evaluate(start));
+    for (size_t i = 1; i < breaks.size(); i++) {
+        const Point p0 = points.back();
+        const Point p1 = evaluate(breaks[i]);
+        subdivide(breaks[i - 1], p0, breaks[i], p1, tolerance, 0, points);
+        points.push_back(p1);
+    }
+    return points;
+}
+
+void Spline::subdivide(const double t0, const Point& p0, const double t1, const Point& p1, const double tolerance, const int depth, std::vector<Point>& points) const {
+    // Probe a few interior parameters, a single midpoint misses S-shaped pieces
+    const double tm = (t0 + t1) / 2.0;
+    const Point pm = evaluate(tm);
+    double deviation = lineDistance(p0.x, p0.y, p1.x, p1.y, pm);
+    for (const double f : {0.25, 0.75}) {
+        deviation = std::max(deviation, lineDistance(p0.x, p0.y, p1.x, p1.y, evaluate(t0 + (t1 - t0) * f)));
+    }
+    if (deviation <= tolerance || depth >= MAX_DEPTH) {
+        return;
+    }
+    subdivide(t0, p0, tm, pm, tolerance, depth + 1, points);
+    points.push_back(pm);
+    subdivide(tm, pm, t1, p1, tolerance, depth + 1, points);
+}
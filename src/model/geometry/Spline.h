@@ -0,0 +1,36 @@
+//
+// Rational B-spline curve with adaptive tessellation into line segments.
+//
+
+#ifndef TURNLAB_SPLINE_H
+#define TURNLAB_SPLINE_H
+
+#include <vector>
+
+#include "Point.h"
+
+class Spline {
+public:
+    int degree;
+    std::vector<Point> controlPoints;
+    std::vector<double> knots;
+    // One weight per control point, empty for non-rational splines
+    std::vector<double> weights;
+
+    // Throws std::invalid_argument if the knot vector or weights don't match the control points
+    Spline(int degree, std::vector<Point> controlPoints, std::vector<double> knots, std::vector<double> weights = {});
+
+    double startParameter() const;
+    double endParameter() const;
+
+    Point evaluate(double t) const;
+
+    // Points along the curve, including both ends, such that every chord stays within
+    // tolerance of the curve. Flat stretches produce few points, tight bends many.
+    std::vector<Point> tessellate(double tolerance) const;
+
+private:
+    void subdivide(double t0, const Point& p0, double t1, const Point& p1, double tolerance, int depth, std::vector<Point>& points) const;
+};
+
+#endif //TURNLAB_SPLINE_H
@@ -0,0 +1,177 @@
+//
+// Connectivity of segments: ordered open and closed chains, gaps and T-junctions.
+//
+
+#include "Topology.h"
+
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+#include "PointGrid.h"
+#include "SegmentBVH.h"
+
+Point Topology::start(const ChainElement& element, const SegmentStore& segments) const {
+    return element.reversed ? segments.endPoint(element.segment) : segments.startPoint(element.segment);
+}
+
+Point Topology::end(const ChainElement& element, const SegmentStore& segments) const {
+    return element.reversed ? segments.startPoint(element.segment) : segments.endPoint(element.segment);
+}
+
+// Builds the topology of segments; ids maps local segment indices to the indices reported in the result
+static Topology build(const SegmentStore& segments, const std::vector<uint32_t>& ids, const TopologyOptions& options) {
+    Topology topology;
+    WeldedVertices welded = weldEndpoints(segments, options.tolerance);
+    const size_t vertexCount = welded.points.size();
+    const size_t segmentCount = segments.size();
+
+    // Vertex to incident segment lookup in compressed row form
+    std::vector<uint32_t> degree(vertexCount, 0);
+    std::vector<bool> used(segmentCount, false);
+    for (size_t i = 0; i < segmentCount; i++) {
+        if (welded.startVertex[i] == welded.endVertex[i]) {
+            topology.degenerateSegments.push_back(ids[i]);
+            used[i] = true;
+            continue;
+        }
+        degree[welded.startVertex[i]]++;
+        degree[welded.endVertex[i]]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] = offsets[v] + degree[v];
+    }
+    std::vector<uint32_t> incident(offsets[vertexCount]);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < segmentCount; i++) {
+        if (welded.startVertex[i] != welded.endVertex[i]) {
+            incident[fill[welded.startVertex[i]]++] = static_cast<uint32_t>(i);
+            incident[fill[welded.endVertex[i]]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    const auto walk = [&](const uint32_t startVertex, uint32_t segment) {
+        Chain chain;
+        uint32_t vertex = startVertex;
+        chain.vertices.push_back(vertex);
+        while (true) {
+            used[segment] = true;
+            const bool reversed = welded.startVertex[segment] != vertex;
+            chain.elements.push_back({ids[segment], reversed});
+            vertex = reversed ? welded.startVertex[segment] : welded.endVertex[segment];
+            chain.vertices.push_back(vertex);
+            if (degree[vertex] != 2 || vertex == startVertex) {
+                break;
+            }
+            // Continue with the other segment at this pass-through vertex
+            const uint32_t a = incident[offsets[vertex]];
+            const uint32_t b = incident[offsets[vertex] + 1];
+            const uint32_t next = a == segment ? b : a;
+            if (used[next]) {
+                break;
+            }
+            segment = next;
+        }
+        chain.closed = chain.vertices.front() == chain.vertices.back();
+        topology.chains.push_back(std::move(chain));
+    };
+
+    // Open chains start and end at dangling or branch vertices
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        if (degree[v] == 2) {
+            continue;
+        }
+        for (uint32_t k = offsets[v]; k < offsets[v + 1]; k++) {
+            if (!used[incident[k]]) {
+                walk(v, incident[k]);
+            }
+        }
+    }
+    // Whatever is left consists of loops through pass-through vertices only
+    for (uint32_t i = 0; i < segmentCount; i++) {
+        if (!used[i]) {
+            walk(welded.startVertex[i], i);
+        }
+    }
+
+    // Pair up nearby dangling ends as gaps
+    std::vector<uint32_t> dangling;
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        if (degree[v] == 1) {
+            dangling.push_back(v);
+        }
+    }
+    if (options.gapDistance > options.tolerance) {
+        PointGrid danglingGrid(options.gapDistance);
+        for (const uint32_t v : dangling) {
+            danglingGrid.add(welded.points[v]);
+        }
+        std::vector<bool> paired(dangling.size(), false);
+        for (size_t a = 0; a < dangling.size(); a++) {
+            if (paired[a]) {
+                continue;
+            }
+            const Point& p = welded.points[dangling[a]];
+            size_t best = a;
+            double bestDistance = INFINITY;
+            for (const size_t b : danglingGrid.within(p, options.gapDistance)) {
+                if (b == a || paired[b]) {
+                    continue;
+                }
+                const Point& q = welded.points[dangling[b]];
+                const double distance = std::hypot(q.x - p.x, q.y - p.y);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = b;
+                }
+            }
+            if (best != a) {
+                paired[a] = paired[best] = true;
+                topology.gaps.push_back({dangling[a], dangling[best], bestDistance});
+            }
+        }
+    }
+
+    // Branch vertices and vertices touching the interior of another segment
+    const SegmentBVH tree(segments);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        if (degree[v] > 2) {
+            topology.junctions.push_back({v, TJunction::NO_SEGMENT});
+        }
+        const Point& p = welded.points[v];
+        const BoundingBox box{p.x - options.tolerance, p.y - options.tolerance, p.x + options.tolerance, p.y + options.tolerance};
+        for (const size_t i : tree.query(box)) {
+            if (welded.startVertex[i] == v || welded.endVertex[i] == v) {
+                continue;
+            }
+            if (segments.distance(i, p) <= options.tolerance) {
+                topology.junctions.push_back({v, ids[i]});
+            }
+        }
+    }
+
+    topology.vertices = std::move(welded.points);
+    spdlog::debug("Topology: {} chains, {} gaps, {} junctions from {} segments",
+                  topology.chains.size(), topology.gaps.size(), topology.junctions.size(), segmentCount);
+    return topology;
+}
+
+Topology buildTopology(const SegmentStore& segments, const TopologyOptions& options) {
+    std::vector<uint32_t> ids(segments.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        ids[i] = static_cast<uint32_t>(i);
+    }
+    return build(segments, ids, options);
+}
+
+Topology buildTopology(const SegmentStore& segments, const std::vector<size_t>& selection, const TopologyOptions& options) {
+    SegmentStore selected;
+    selected.reserve(selection.size());
+    std::vector<uint32_t> ids;
+    ids.reserve(selection.size());
+    for (const size_t index : selection) {
+        selected.append(segments, index);
+        ids.push_back(static_cast<uint32_t>(index));
+    }
+    return build(selected, ids, options);
+}
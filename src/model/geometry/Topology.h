@@ -0,0 +1,72 @@
+//
+// Connectivity of segments: ordered open and closed chains, gaps and T-junctions.
+//
+
+#ifndef TURNLAB_TOPOLOGY_H
+#define TURNLAB_TOPOLOGY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point.h"
+#include "SegmentStore.h"
+
+struct TopologyOptions {
+    // Endpoints closer than this are considered connected
+    double tolerance = 1e-6;
+    // Dangling endpoints closer than this (but not connected) are reported as gaps
+    double gapDistance = 0.1;
+};
+
+// One segment of a chain, traversed end to start if reversed is set
+struct ChainElement {
+    uint32_t segment;
+    bool reversed;
+};
+
+struct Chain {
+    std::vector<ChainElement> elements;
+    // Welded vertex indices along the chain, elements.size() + 1 entries.
+    // For closed chains the last vertex equals the first one.
+    std::vector<uint32_t> vertices;
+    bool closed = false;
+};
+
+// Two dangling chain ends that almost, but not quite, meet
+struct TopologyGap {
+    uint32_t vertexA;
+    uint32_t vertexB;
+    double distance;
+};
+
+// A vertex where the profile branches: either more than two segment ends meet,
+// or a segment ends on the interior of another segment
+struct TJunction {
+    uint32_t vertex;
+    // Segment whose interior the vertex touches, or NO_SEGMENT for a plain branch vertex
+    uint32_t segment;
+
+    static constexpr uint32_t NO_SEGMENT = UINT32_MAX;
+};
+
+struct Topology {
+    std::vector<Point> vertices;
+    std::vector<Chain> chains;
+    std::vector<TopologyGap> gaps;
+    std::vector<TJunction> junctions;
+    // Segments whose endpoints weld into one vertex, not part of any chain
+    std::vector<uint32_t> degenerateSegments;
+
+    // Segment endpoints oriented along the chain
+    Point start(const ChainElement& element, const SegmentStore& segments) const;
+    Point end(const ChainElement& element, const SegmentStore& segments) const;
+};
+
+// Chains all segments of the store
+Topology buildTopology(const SegmentStore& segments, const TopologyOptions& options = {});
+
+// Chains only the selected segments, e.g. an operation's geometry selection
+Topology buildTopology(const SegmentStore& segments, const std::vector<size_t>& selection, const TopologyOptions& options = {});
+
+#endif //TURNLAB_TOPOLOGY_H
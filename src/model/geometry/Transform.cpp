@@ -5,6 +5,9 @@
 #include "Transform.h"
 
 #include <cmath>
+#include <stdexcept>
+
+#include "Point.h"
 
 Transform Transform::identity() {
     return {};
@@ -34,4 +37,35 @@ Transform Transform::mirrorX() {
 
 Transform Transform::mirrorY() {
     return scale(1.0, -1.0);
-}
\ No newline at end of file
+}
+Transform Transform::operator*(const Transform& other) const {
+    Transform t;
+    for (int r = 0; r < 2; r++) {
+        for (int c = 0; c < 2; c++) {
+            t.linear[r][c] = linear[r][0] * other.linear[0][c] + linear[r][1] * other.linear[1][c];
+        }
+        t.translation[r] = linear[r][0] * other.translation[0] + linear[r][1] * other.translation[1] + translation[r];
+    }
+    return t;
+}
+
+double Transform::determinant() const {
+    return linear[0][0] * linear[1][1] - linear[0][1] * linear[1][0];
+}
+
+Transform Transform::inverse() const {
+    const double det = determinant();
+    if (det == 0.0) {
+        throw std::domain_error("Transform is not invertible");
+    }
+    Transform t;
+    t.linear = {{{linear[1][1] / det, -linear[0][1] / det}, {-linear[1][0] / det, linear[0][0] / det}}};
+    t.translation[0] = -(t.linear[0][0] * translation[0] + t.linear[0][1] * translation[1]);
+    t.translation[1] = -(t.linear[1][0] * translation[0] + t.linear[1][1] * translation[1]);
+    return t;
+}
+
+Point Transform::apply(const Point& point) const {
+    return {linear[0][0] * point.x + linear[0][1] * point.y + translation[0],
+            linear[1][0] * point.x + linear[1][1] * point.y + translation[1]};
+}
@@ -6,6 +6,8 @@
 #define TURNLAB_TRANSFORM_H
 #include <array>
 
+class Point;
+
 
 class Transform {
 public:
@@ -19,6 +21,13 @@ public:
     static Transform mirrorX();
     static Transform mirrorY();
 
+    // Composition: (a * b) applies b first, then a
+    Transform operator*(const Transform& other) const;
+    Transform inverse() const;
+    double determinant() const;
+
+    Point apply(const Point& point) const;
+
 };
 
 
@@ -0,0 +1,21 @@
+//
+// Batch application of affine transforms to coordinate arrays.
+//
+
+#ifndef TURNLAB_TRANSFORMKERNEL_H
+#define TURNLAB_TRANSFORMKERNEL_H
+
+#include <cstddef>
+
+#include "Transform.h"
+
+// Transform count points in place, x and y coordinates stored in separate arrays.
+// Uses AVX2 when the CPU supports it and falls back to a scalar loop otherwise.
+void transformPoints(const Transform& transformation, double* xs, double* ys, size_t count);
+
+// Scalar reference implementation, produces bit-identical results to the vector path
+void transformPointsScalar(const Transform& transformation, double* xs, double* ys, size_t count);
+
+bool transformKernelUsesAvx2();
+
+#endif //TURNLAB_TRANSFORMKERNEL_H
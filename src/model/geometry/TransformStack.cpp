@@ -0,0 +1,24 @@
+//
+// Running composition of the transformations applied during DXF import.
+//
+
+#include "TransformStack.h"
+
+void TransformStack::push(const Transform& transformation) {
+    history.push_back(transformation);
+    current = transformation * current;
+}
+
+bool TransformStack::undo() {
+    if (history.empty()) {
+        return false;
+    }
+    current = history.back().inverse() * current;
+    history.pop_back();
+    return true;
+}
+
+void TransformStack::clear() {
+    history.clear();
+    current = Transform::identity();
+}
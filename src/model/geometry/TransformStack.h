@@ -0,0 +1,32 @@
+//
+// Running composition of the transformations applied during DXF import.
+//
+
+#ifndef TURNLAB_TRANSFORMSTACK_H
+#define TURNLAB_TRANSFORMSTACK_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Transform.h"
+
+class TransformStack {
+public:
+    // Apply a transformation after all previously pushed ones
+    void push(const Transform& transformation);
+
+    // Revert the most recent transformation; returns false if there is nothing to undo
+    bool undo();
+
+    void clear();
+
+    const Transform& composed() const { return current; }
+    size_t size() const { return history.size(); }
+    bool empty() const { return history.empty(); }
+
+private:
+    std::vector<Transform> history;
+    Transform current;
+};
+
+#endif //TURNLAB_TRANSFORMSTACK_H
@@ -67,14 +67,16 @@ struct OperationConfiguration {
     double peckDepth = 3.0;         // mm
     int dwellTime = 500;            // ms
     double backoffDistance = 1.0;   // mm
+    double stockAllowance = 0.0;    // mm left on the profile
 
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(OperationConfiguration,
+    // Fields missing from projects saved by older versions keep their defaults
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(OperationConfiguration,
         operationType,
         toolNumber, rpm, feedrate,
         geometrySelection,
         axialStartPosition, axialEndPosition, axialStartOffset, axialEndOffset,
         retractDistance, clearanceDistance, feedDistance, outerDistance, innerDistance,
-        stepover, cutDepthPerPass, springPasses, peckDepth, dwellTime, backoffDistance)
+        stepover, cutDepthPerPass, springPasses, peckDepth, dwellTime, backoffDistance, stockAllowance)
 };
 
 struct OperationConfigVisibility {
@@ -103,6 +105,7 @@ struct OperationConfigVisibility {
     bool showPeckDepth = false;
     bool showDwellTime = false;
     bool showBackoffDistance = false;
+    bool showStockAllowance = false;
 
     // Tab visibility
     bool showToolTab = false;
@@ -114,7 +117,7 @@ struct OperationConfigVisibility {
         showToolSelector, showRpmInput, showFeedrateInput,
         showGeometrySelection, singleSegmentSelection, showAxialStartOffset, showAxialEndOffset,
         showRetractDistance, showClearanceDistance, showFeedDistance, showOuterDistance, showInnerDistance,
-        showStepover, showCutDepthPerPass, showSpringPasses, showPeckDepth, showDwellTime, showBackoffDistance,
+        showStepover, showCutDepthPerPass, showSpringPasses, showPeckDepth, showDwellTime, showBackoffDistance, showStockAllowance,
         showToolTab, showGeometryTab, showRadiiTab, showPassesTab)
 };
 
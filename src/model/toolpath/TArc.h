@@ -0,0 +1,58 @@
+//
+// Circular toolpath move, emitted as G02/G03 by the post-processor.
+//
+
+#ifndef TURNLAB_TARC_H
+#define TURNLAB_TARC_H
+
+#include "TToolpath.h"
+#include "TPoint.h"
+
+class TArc : public TToolpath {
+public:
+    TPoint start;
+    TPoint end;
+    TPoint center;
+    // Turning direction when viewed with Z to the right and X pointing up
+    bool clockwise = false;
+
+    TArc() : TToolpath(TToolpathType::Arc) {}
+
+    TArc(const TPoint& start, const TPoint& end, const TPoint& center, bool clockwise, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0, TMoveKind kind = TMoveKind::Feed)
+        : TToolpath(TToolpathType::Arc, toolNumber, feedRate, rpm, kind), start(start), end(end), center(center), clockwise(clockwise) {}
+
+    TPoint getStartPosition() override {
+        return start;
+    }
+
+    nlohmann::json toJson() const override {
+        nlohmann::json j;
+        j["toolNumber"] = toolNumber;
+        j["feedRate"] = feedRate;
+        j["rpm"] = rpm;
+        j["type"] = type;
+        j["kind"] = kind;
+        j["start"] = start;
+        j["end"] = end;
+        j["center"] = center;
+        j["clockwise"] = clockwise;
+        return j;
+    }
+
+    void fromJson(const nlohmann::json& j) override {
+        j.at("toolNumber").get_to(toolNumber);
+        j.at("feedRate").get_to(feedRate);
+        j.at("rpm").get_to(rpm);
+        j.at("type").get_to(type);
+        // Older files carry no kind, everything was a feed move
+        kind = j.value("kind", TMoveKind::Feed);
+        j.at("start").get_to(start);
+        j.at("end").get_to(end);
+        j.at("center").get_to(center);
+        j.at("clockwise").get_to(clockwise);
+    }
+
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(TArc, toolNumber, feedRate, rpm, type, kind, start, end, center, clockwise)
+};
+
+#endif //TURNLAB_TARC_H
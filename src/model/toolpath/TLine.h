@@ -15,11 +15,11 @@ public:
 
     TLine() : TToolpath(TToolpathType::Line) {}
 
-    TLine(const TPoint& start, const TPoint& end, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0)
-        : TToolpath(TToolpathType::Line, toolNumber, feedRate, rpm), start(start), end(end) {}
+    TLine(const TPoint& start, const TPoint& end, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0, TMoveKind kind = TMoveKind::Feed)
+        : TToolpath(TToolpathType::Line, toolNumber, feedRate, rpm, kind), start(start), end(end) {}
 
-    TLine(double startX, double startZ, double endX, double endZ, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0)
-        : TToolpath(TToolpathType::Line, toolNumber, feedRate, rpm), start(startX, startZ), end(endX, endZ) {}
+    TLine(double startX, double startZ, double endX, double endZ, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0, TMoveKind kind = TMoveKind::Feed)
+        : TToolpath(TToolpathType::Line, toolNumber, feedRate, rpm, kind), start(startX, startZ), end(endX, endZ) {}
 
     TPoint getStartPosition() override {
         return start;
@@ -31,6 +31,7 @@ public:
         j["feedRate"] = feedRate;
         j["rpm"] = rpm;
         j["type"] = type;
+        j["kind"] = kind;
         j["start"] = start;
         j["end"] = end;
         return j;
@@ -41,11 +42,13 @@ public:
         j.at("feedRate").get_to(feedRate);
         j.at("rpm").get_to(rpm);
         j.at("type").get_to(type);
+        // Older files carry no kind, everything was a feed move
+        kind = j.value("kind", TMoveKind::Feed);
         j.at("start").get_to(start);
         j.at("end").get_to(end);
     }
 
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(TLine, toolNumber, feedRate, rpm, type, start, end)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(TLine, toolNumber, feedRate, rpm, type, kind, start, end)
 };
 
 #endif //TURNLAB_TLINE_H
\ No newline at end of file
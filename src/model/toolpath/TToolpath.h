@@ -5,21 +5,54 @@
 #ifndef TURNLAB_TTOOLPATH_H
 #define TURNLAB_TTOOLPATH_H
 
+#include <cstdint>
 #include <nlohmann/json.hpp>
 
 #include "TPoint.h"
 
-enum class TToolpathType {
-    Line
+enum class TToolpathType : uint8_t {
+    Line,
+    Arc
 };
 
 NLOHMANN_JSON_SERIALIZE_ENUM(TToolpathType, {
-    {TToolpathType::Line, "Line"}
+    {TToolpathType::Line, "Line"},
+    {TToolpathType::Arc, "Arc"}
 })
 
 inline std::string toString(TToolpathType type) {
     switch (type) {
         case TToolpathType::Line: return "Line";
+        case TToolpathType::Arc: return "Arc";
+        default: return "Unknown";
+    }
+}
+
+// What a move does, independent of its shape. Rapids are traversed at machine speed, the
+// other kinds run at their feed rate. A dwell holds position for its duration.
+enum class TMoveKind : uint8_t {
+    Rapid,
+    Feed,
+    Retract,
+    Plunge,
+    Dwell
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(TMoveKind, {
+    {TMoveKind::Rapid, "Rapid"},
+    {TMoveKind::Feed, "Feed"},
+    {TMoveKind::Retract, "Retract"},
+    {TMoveKind::Plunge, "Plunge"},
+    {TMoveKind::Dwell, "Dwell"}
+})
+
+inline std::string toString(TMoveKind kind) {
+    switch (kind) {
+        case TMoveKind::Rapid: return "Rapid";
+        case TMoveKind::Feed: return "Feed";
+        case TMoveKind::Retract: return "Retract";
+        case TMoveKind::Plunge: return "Plunge";
+        case TMoveKind::Dwell: return "Dwell";
         default: return "Unknown";
     }
 }
@@ -30,9 +63,10 @@ public:
     double feedRate = 100.0;  // mm/min
     double rpm = 1000.0;
     TToolpathType type;
+    TMoveKind kind = TMoveKind::Feed;
 
-    TToolpath(TToolpathType type, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0)
-        : type(type), toolNumber(toolNumber), feedRate(feedRate), rpm(rpm) {}
+    TToolpath(TToolpathType type, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0, TMoveKind kind = TMoveKind::Feed)
+        : type(type), toolNumber(toolNumber), feedRate(feedRate), rpm(rpm), kind(kind) {}
 
     virtual ~TToolpath() = default;
 
@@ -43,7 +77,7 @@ public:
     virtual nlohmann::json toJson() const = 0;
     virtual void fromJson(const nlohmann::json& j) = 0;
 
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(TToolpath, toolNumber, feedRate, rpm, type)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(TToolpath, toolNumber, feedRate, rpm, type, kind)
 };
 
 #endif //TURNLAB_TTOOLPATH_H
\ No newline at end of file
@@ -5,80 +5,230 @@
 #ifndef TURNLAB_TTOOLPATHSEQUENCE_H
 #define TURNLAB_TTOOLPATHSEQUENCE_H
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 #include <vector>
-#include <memory>
 #include <nlohmann/json.hpp>
 #include "TToolpath.h"
 #include "TLine.h"
+#include "TArc.h"
+#include "../../utils/Generator.h"
 
+// One move of a sequence. Tool, feed and spindle speed live in the sequence's state runs.
+struct TMove {
+    TPoint start;
+    TPoint end;
+    // Only meaningful for arcs
+    TPoint center;
+    TToolpathType type = TToolpathType::Line;
+    TMoveKind kind = TMoveKind::Feed;
+    bool clockwise = false;
+    // Dwell time in seconds, start and end coincide for a dwell
+    double duration = 0.0;
+};
+
+static_assert(std::is_trivially_copyable_v<TMove>);
+static_assert(sizeof(TMove) <= 64, "Moves should stay within a cache line");
+
+// Machine state in effect from a given move onwards
+struct TMoveState {
+    int toolNumber = 0;
+    double feedRate = 100.0;  // mm/min
+    double rpm = 1000.0;
+
+    bool operator==(const TMoveState&) const = default;
+};
+
+// A move together with the state it is executed in
+struct TMoveRef {
+    const TMove& move;
+    const TMoveState& state;
+};
+
+// A move with its state by value, as produced by move streams
+struct TStreamedMove {
+    TMove move;
+    TMoveState state;
+};
+
+// Lazily generated moves, for consumers that do not need the whole sequence at once
+using TMoveStream = Generator<TStreamedMove>;
+
+// Stores moves contiguously, with tool, feed and spindle speed run-length encoded: a new state
+// run only starts when one of them changes, which for generated programs is a handful of times.
 class TToolpathSequence {
 public:
-    std::vector<std::unique_ptr<TToolpath>> toolpaths;
+    struct StateRun {
+        size_t firstMove;
+        TMoveState state;
+    };
+
+    // Walks moves and state runs in lockstep, no lookup per move
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TMoveRef;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator() = default;
+        const_iterator(const TToolpathSequence* sequence, size_t index) : sequence(sequence), index(index) {}
+
+        TMoveRef operator*() const {
+            return {sequence->moveList[index], sequence->stateRuns[run].state};
+        }
+
+        const_iterator& operator++() {
+            index++;
+            if (run + 1 < sequence->stateRuns.size() && sequence->stateRuns[run + 1].firstMove == index) {
+                run++;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+
+    private:
+        const TToolpathSequence* sequence = nullptr;
+        size_t index = 0;
+        size_t run = 0;
+    };
 
     TToolpathSequence() = default;
-    TToolpathSequence(std::vector<std::unique_ptr<TToolpath>> toolpaths) : toolpaths(std::move(toolpaths)) {}
 
-    // Move constructor
-    TToolpathSequence(TToolpathSequence&& other) noexcept
-        : toolpaths(std::move(other.toolpaths)) {}
+    void addMove(const TMove& move, const TMoveState& state) {
+        if (stateRuns.empty() || stateRuns.back().state != state) {
+            stateRuns.push_back({moveList.size(), state});
+        }
+        moveList.push_back(move);
+    }
 
-    // Move assignment operator
-    TToolpathSequence& operator=(TToolpathSequence&& other) noexcept {
-        if (this != &other) {
-            toolpaths = std::move(other.toolpaths);
+    // Collects a stream into this sequence
+    void append(TMoveStream stream) {
+        for (const TStreamedMove& streamed : stream) {
+            addMove(streamed.move, streamed.state);
         }
-        return *this;
     }
 
-    // Delete copy constructor and copy assignment operator
-    TToolpathSequence(const TToolpathSequence&) = delete;
-    TToolpathSequence& operator=(const TToolpathSequence&) = delete;
+    void addLine(const TPoint& start, const TPoint& end, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0, TMoveKind kind = TMoveKind::Feed) {
+        addMove({start, end, {}, TToolpathType::Line, kind, false}, {toolNumber, feedRate, rpm});
+    }
+
+    void addLine(double startX, double startZ, double endX, double endZ, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0, TMoveKind kind = TMoveKind::Feed) {
+        addLine(TPoint(startX, startZ), TPoint(endX, endZ), toolNumber, feedRate, rpm, kind);
+    }
 
-    void addToolpath(std::unique_ptr<TToolpath> toolpath) {
-        toolpaths.push_back(std::move(toolpath));
+    void addLine(const TLine& line) {
+        addLine(line.start, line.end, line.toolNumber, line.feedRate, line.rpm, line.kind);
     }
 
-    void addLine(const TPoint& start, const TPoint& end, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0) {
-        auto line = std::make_unique<TLine>(start, end, toolNumber, feedRate, rpm);
-        addToolpath(std::move(line));
+    void addArc(const TPoint& start, const TPoint& end, const TPoint& center, bool clockwise, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0, TMoveKind kind = TMoveKind::Feed) {
+        addMove({start, end, center, TToolpathType::Arc, kind, clockwise}, {toolNumber, feedRate, rpm});
     }
 
-    void addLine(double startX, double startZ, double endX, double endZ, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0) {
-        auto line = std::make_unique<TLine>(startX, startZ, endX, endZ, toolNumber, feedRate, rpm);
-        addToolpath(std::move(line));
+    void addArc(const TArc& arc) {
+        addArc(arc.start, arc.end, arc.center, arc.clockwise, arc.toolNumber, arc.feedRate, arc.rpm, arc.kind);
+    }
+
+    void addRapid(const TPoint& start, const TPoint& end, int toolNumber = 0, double feedRate = 100.0, double rpm = 1000.0) {
+        addLine(start, end, toolNumber, feedRate, rpm, TMoveKind::Rapid);
+    }
+
+    // Keeps the current feed rate so a dwell does not split a state run
+    void addDwell(const TPoint& position, double seconds, int toolNumber = 0, double rpm = 1000.0) {
+        const double feedRate = stateRuns.empty() ? 100.0 : stateRuns.back().state.feedRate;
+        addMove({position, position, {}, TToolpathType::Line, TMoveKind::Dwell, false, seconds}, {toolNumber, feedRate, rpm});
+    }
+
+    const std::vector<TMove>& moves() const {
+        return moveList;
+    }
+
+    const std::vector<StateRun>& states() const {
+        return stateRuns;
+    }
+
+    const TMove& operator[](size_t index) const {
+        return moveList[index];
+    }
+
+    // Binary search over the state runs, prefer iterating when visiting every move
+    const TMoveState& stateAt(size_t index) const {
+        const auto run = std::upper_bound(stateRuns.begin(), stateRuns.end(), index,
+                                          [](size_t i, const StateRun& r) { return i < r.firstMove; });
+        return std::prev(run)->state;
+    }
+
+    const_iterator begin() const {
+        return {this, 0};
+    }
+
+    const_iterator end() const {
+        return {this, moveList.size()};
     }
 
     size_t size() const {
-        return toolpaths.size();
+        return moveList.size();
     }
 
     bool empty() const {
-        return toolpaths.empty();
+        return moveList.empty();
     }
 
     void clear() {
-        toolpaths.clear();
+        moveList.clear();
+        stateRuns.clear();
     }
 
-    // JSON serialization
+    void reserve(size_t moves) {
+        moveList.reserve(moves);
+    }
+
+    // JSON serialization, one object per move as written by TLine and TArc, dwells add their duration
     nlohmann::json toJson() const {
         nlohmann::json j = nlohmann::json::array();
-        for (const auto& toolpath : toolpaths) {
-            j.push_back(toolpath->toJson());
+        for (const auto [move, state] : *this) {
+            if (move.type == TToolpathType::Arc) {
+                j.push_back(TArc(move.start, move.end, move.center, move.clockwise, state.toolNumber, state.feedRate, state.rpm, move.kind).toJson());
+            } else {
+                j.push_back(TLine(move.start, move.end, state.toolNumber, state.feedRate, state.rpm, move.kind).toJson());
+            }
+            if (move.kind == TMoveKind::Dwell) {
+                j.back()["duration"] = move.duration;
+            }
         }
         return j;
     }
 
     void fromJson(const nlohmann::json& j) {
         clear();
+        reserve(j.size());
         for (const auto& item : j) {
             TToolpathType type = item.at("type").get<TToolpathType>();
 
             switch (type) {
                 case TToolpathType::Line: {
-                    auto line = std::make_unique<TLine>();
-                    line->fromJson(item);
-                    addToolpath(std::move(line));
+                    TLine line;
+                    line.fromJson(item);
+                    if (line.kind == TMoveKind::Dwell) {
+                        addMove({line.start, line.start, {}, TToolpathType::Line, TMoveKind::Dwell, false, item.value("duration", 0.0)},
+                                {line.toolNumber, line.feedRate, line.rpm});
+                    } else {
+                        addLine(line);
+                    }
+                    break;
+                }
+                case TToolpathType::Arc: {
+                    TArc arc;
+                    arc.fromJson(item);
+                    addArc(arc);
                     break;
                 }
                 default:
@@ -87,8 +237,19 @@ public:
             }
         }
     }
+
+private:
+    std::vector<TMove> moveList;
+    std::vector<StateRun> stateRuns;
 };
 
+// Streams the moves of a sequence, which has to outlive the stream
+inline TMoveStream streamMoves(const TToolpathSequence& sequence) {
+    for (const auto [move, state] : sequence) {
+        co_yield TStreamedMove{move, state};
+    }
+}
+
 // Custom JSON serialization for TToolpathSequence
 inline void to_json(nlohmann::json& j, const TToolpathSequence& sequence) {
     j = sequence.toJson();
@@ -98,4 +259,4 @@ inline void from_json(const nlohmann::json& j, TToolpathSequence& sequence) {
     sequence.fromJson(j);
 }
 
-#endif //TURNLAB_TTOOLPATHSEQUENCE_H
\ No newline at end of file
+#endif //TURNLAB_TTOOLPATHSEQUENCE_H
@@ -10,6 +10,7 @@
 #include "TPoint.h"
 #include "TToolpath.h"
 #include "TLine.h"
+#include "TArc.h"
 #include "TToolpathSequence.h"
 
 #endif //TURNLAB_TOOLPATH_H
\ No newline at end of file
@@ -4,7 +4,10 @@
 
 #include "DXFImportPresenter.h"
 #include "../utils/DXFUtils.h"
+#include "../utils/ConfigurationManager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <QMessageBox>
 #include <QFileInfo>
 #include <QFileDialog>
@@ -14,6 +17,19 @@
 #include "Line.h"
 #include "../model/MachineConfig.h"
 
+namespace {
+    // Millimeters per drawing unit of the units selected in the dialog
+    double millimetersPerUnit(const QString& units) {
+        if (units == "m") {
+            return 1000.0; // 1 m = 1000 mm
+        }
+        if (units == "inch") {
+            return 25.4; // 1 inch = 25.4 mm
+        }
+        return 1.0;
+    }
+}
+
 DXFImportPresenter::DXFImportPresenter(const std::string& dxfFilePath, const MachineConfig& config, QWidget* parent) : machineConfig(config), QObject(parent) {
     dialog = std::make_unique<DXFImportDialog>(machineConfig, parent);
     connectSignals();
@@ -25,6 +41,10 @@ DXFImportPresenter::DXFImportPresenter(const std::string& dxfFilePath, const Mac
     }
 }
 
+DXFImportPresenter::~DXFImportPresenter() {
+    cancelImport();
+}
+
 void DXFImportPresenter::connectSignals() {
     connect(dialog.get(), &DXFImportDialog::activateCenterLineSelection, this, &DXFImportPresenter::activateCenterLineSelection);
     connect(dialog.get(), &DXFImportDialog::activateZeroPointSelection, this, &DXFImportPresenter::activateZeroPointSelection);
@@ -39,6 +59,8 @@ void DXFImportPresenter::connectSignals() {
     connect(dialog.get(), &DXFImportDialog::onAxialOffsetChanged, this, &DXFImportPresenter::onAxialOffsetChanged);
     connect(dialog.get(), &DXFImportDialog::onRadialOffsetChanged, this, &DXFImportPresenter::onRadialOffsetChanged);
     connect(dialog.get(), &DXFImportDialog::onUnitsChanged, this, &DXFImportPresenter::onUnitsChanged);
+    connect(dialog.get(), &DXFImportDialog::layerSelectionChanged, this, &DXFImportPresenter::onLayerSelectionChanged);
+    connect(dialog.get(), &DXFImportDialog::simplifyRequested, this, &DXFImportPresenter::onSimplifyRequested);
 
     connect(dialog.get(), &DXFImportDialog::onStockStartOffsetChanged, this, &DXFImportPresenter::onStockStartOffsetChanged);
     connect(dialog.get(), &DXFImportDialog::onStockEndOffsetChanged, this, &DXFImportPresenter::onStockEndOffsetChanged);
@@ -49,6 +71,8 @@ void DXFImportPresenter::connectSignals() {
 
     connect(dialog.get(), &DXFImportDialog::importAccepted, this, &DXFImportPresenter::onImportAccepted);
     connect(dialog.get(), &DXFImportDialog::importCancelled, this, &DXFImportPresenter::onImportCancelled);
+
+    connect(this, &DXFImportPresenter::importProgress, dialog.get(), &DXFImportDialog::setImportProgress);
 }
 
 std::optional<Project> DXFImportPresenter::showDialog() const {
@@ -61,7 +85,7 @@ std::optional<Project> DXFImportPresenter::showDialog() const {
         // Import button was pressed
         Project project = {
             .savePath = projectFilePath.toStdString(),
-            .geometry = geometry->transform(transformations),
+            .geometry = geometry->transform(transformations.composed()),
             .stockMaterial = stockMaterial
         };
         return project;
@@ -77,33 +101,195 @@ void DXFImportPresenter::setGeometry(const Geometry& geom) {
 }
 
 bool DXFImportPresenter::loadDXFFile(const QString& filePath) {
-    try {
-        // Check if file exists
-        const QFileInfo fileInfo(filePath);
-        if (!fileInfo.exists() || !fileInfo.isReadable()) {
-            return false;
+    // Check if file exists
+    const QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists() || !fileInfo.isReadable()) {
+        return false;
+    }
+
+    cancelImport();
+    if (filePath != dxfFilePath) {
+        dxfFilePath = filePath;
+        importOptions = {};
+        layerStatistics.clear();
+    }
+    geometry = std::make_unique<Geometry>();
+    importCancelRequested = false;
+    const uint64_t generation = ++importGeneration;
+
+    // Set dialog title to include filename
+    dialog->setWindowTitle(QString("DXF Import Configuration - %1").arg(fileInfo.fileName()));
+    dialog->setImportRunning(true);
+
+    // Results are posted back to the GUI thread, queued calls to this presenter are
+    // dropped if it is destroyed first, the destructor waits for the thread to finish
+    const std::filesystem::path path = filePath.toStdString();
+    const std::filesystem::path cacheDirectory = ConfigurationManager::getCacheDirectory();
+    const qint64 totalBytes = fileInfo.size();
+    const bool scanLayers = layerStatistics.empty();
+    // The tolerance is entered in mm, the imported geometry is still in drawing units
+    const double simplifyTolerance = dialog->getSimplifyTolerance() / millimetersPerUnit(previousUnits);
+    importThread.reset(QThread::create([this, generation, path, cacheDirectory, totalBytes, scanLayers, simplifyTolerance,
+                                        options = importOptions] {
+        // A quick pass for the layer list comes first, so heavy layers can be
+        // excluded while the conversion is still running
+        if (scanLayers) {
+            try {
+                auto layers = std::make_shared<std::vector<DXFLayerStatistics>>(DXFStreamReader(path).scanLayers());
+                QMetaObject::invokeMethod(this, [this, generation, layers] {
+                    onLayersScanned(generation, *layers);
+                }, Qt::QueuedConnection);
+            } catch (const std::runtime_error& e) {
+                spdlog::info("Failed to scan DXF layers: {}", e.what());
+            }
+        }
+
+        size_t sent = 0;
+        auto lastPreview = std::chrono::steady_clock::now();
+        const DXFProgressCallback progress = [&](const DXFStreamStatistics& statistics, const SegmentStore& segments) {
+            if (importCancelRequested) {
+                return false;
+            }
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastPreview < std::chrono::milliseconds(DXF_PREVIEW_INTERVAL_MS)) {
+                return true;
+            }
+            lastPreview = now;
+
+            // Only the segments read since the last preview are handed over
+            auto newSegments = std::make_shared<SegmentStore>();
+            newSegments->reserve(segments.size() - sent);
+            for (; sent < segments.size(); sent++) {
+                newSegments->append(segments, sent);
+            }
+            QMetaObject::invokeMethod(this, [this, generation, statistics, totalBytes, newSegments] {
+                onImportProgress(generation, statistics, totalBytes, *newSegments);
+            }, Qt::QueuedConnection);
+            return true;
+        };
+
+        std::shared_ptr<ImportResult> result;
+        QString error;
+        try {
+            const GeometryCache cache(cacheDirectory);
+            const Geometry loaded = loadDXF(path, cache, options, progress);
+            result = std::make_shared<ImportResult>();
+            result->cleanup = cleanupSegments(loaded.segments);
+            result->imported = Geometry(std::move(result->cleanup.segments));
+            result->cleanup.segments.clear();
+            result->simplified = simplifySegments(result->imported.segments, simplifyTolerance);
+        } catch (const DXFImportCancelled&) {
+            spdlog::info("DXF import of {} cancelled", path.string());
+        } catch (const std::exception& e) {
+            spdlog::error("Failed to load DXF file {}: {}", path.string(), e.what());
+            error = e.what();
         }
-        
-        // Load DXF file using DXFUtils
-        Geometry loadedGeometry = loadDXF(filePath.toStdString());
-        setGeometry(loadedGeometry);
-        
-        // Set dialog title to include filename
-        dialog->setWindowTitle(QString("DXF Import Configuration - %1").arg(fileInfo.fileName()));
-        
-        return true;
+        QMetaObject::invokeMethod(this, [this, generation, result, error] {
+            onImportFinished(generation, result, error);
+        }, Qt::QueuedConnection);
+    }));
+    importThread->start();
+    return true;
+}
+
+void DXFImportPresenter::cancelImport() {
+    if (importThread) {
+        importCancelRequested = true;
+        importThread->wait();
+        importThread.reset();
     }
-    catch (const std::exception& e) {
-        // Handle DXF loading errors
-        return false;
+}
+
+void DXFImportPresenter::onImportProgress(const uint64_t generation, const DXFStreamStatistics& statistics, const qint64 totalBytes,
+                                          const SegmentStore& newSegments) {
+    if (generation != importGeneration) {
+        return;
+    }
+    emit importProgress(static_cast<qint64>(statistics.bytesRead), totalBytes, static_cast<qint64>(statistics.entitiesRead));
+    if (!geometry || newSegments.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < newSegments.size(); i++) {
+        geometry->segments.append(newSegments, i);
     }
+    updateGeometryPreview();
+}
+
+void DXFImportPresenter::onLayersScanned(const uint64_t generation, const std::vector<DXFLayerStatistics>& layers) {
+    if (generation != importGeneration) {
+        return;
+    }
+    layerStatistics = layers;
+    dialog->setLayers(layerStatistics, importOptions.layers);
+}
+
+void DXFImportPresenter::onLayerSelectionChanged(const QStringList& keptLayers) {
+    std::vector<std::string> layers;
+    for (const QString& layer : keptLayers) {
+        layers.push_back(layer.toStdString());
+    }
+    // An empty filter keeps everything, so no kept layer means nothing to import
+    if (layers.empty()) {
+        cancelImport();
+        ++importGeneration;
+        dialog->setImportRunning(false);
+        setGeometry(Geometry());
+        return;
+    }
+    importOptions.layers = layers.size() == layerStatistics.size() ? std::vector<std::string>() : std::move(layers);
+    loadDXFFile(dxfFilePath);
+}
+
+void DXFImportPresenter::onImportFinished(const uint64_t generation, const std::shared_ptr<ImportResult>& result, const QString& error) {
+    if (generation != importGeneration) {
+        return;
+    }
+    if (importThread) {
+        importThread->wait();
+        importThread.reset();
+    }
+    dialog->setImportRunning(false);
+
+    // A failed or cancelled import doesn't leave a partial drawing behind
+    if (!result) {
+        importedGeometry = Geometry();
+        setGeometry(Geometry());
+    } else {
+        importedGeometry = std::move(result->imported);
+        showSimplifySummary(result->simplified);
+        setGeometry(Geometry(std::move(result->simplified.segments)));
+        const CleanupResult& cleanup = result->cleanup;
+        dialog->setImportSummary(QString("Removed %1 segments: %2 duplicates, %3 collinear overlaps, %4 degenerate")
+                                     .arg(cleanup.removed())
+                                     .arg(cleanup.duplicatesRemoved)
+                                     .arg(cleanup.overlapsMerged)
+                                     .arg(cleanup.degenerateRemoved));
+    }
+    if (!error.isEmpty()) {
+        QMessageBox::warning(dialog.get(), "DXF Import Error", QString("Failed to load DXF file: %1").arg(error));
+    }
+}
+
+void DXFImportPresenter::onSimplifyRequested(const double tolerance) {
+    // The tolerance is entered in mm, the imported geometry is still in drawing units
+    SimplifyResult simplified = simplifySegments(importedGeometry.segments, tolerance / millimetersPerUnit(previousUnits));
+    showSimplifySummary(simplified);
+    setGeometry(Geometry(std::move(simplified.segments)));
+}
+
+void DXFImportPresenter::showSimplifySummary(const SimplifyResult& result) {
+    const double percent = result.segmentsBefore > 0 ? 100.0 * static_cast<double>(result.removed()) / static_cast<double>(result.segmentsBefore) : 0.0;
+    dialog->setSimplifySummary(QString("%1 of %2 segments left (%3% fewer)")
+                                   .arg(result.segmentsBefore - result.removed())
+                                   .arg(result.segmentsBefore)
+                                   .arg(percent, 0, 'f', 1));
 }
 
 void DXFImportPresenter::updateGeometryPreview() {
     if (geometry && dialog) {
         // Apply current configuration transformations here if needed
         // For now, just pass the geometry to the dialog
-        dialog->setGeometry(geometry->transform(transformations));
+        dialog->setGeometry(geometry->transform(transformations.composed()));
     }
 }
 
@@ -128,14 +314,15 @@ void DXFImportPresenter::activateZeroPointSelection(bool active) {
 
 void DXFImportPresenter::segmentSelected(size_t index) {
     if (state == CENTER_LINE_SELECTION) {
-        if (Line* line = dynamic_cast<Line*>(geometry->segments[index].get())) {
+        if (const auto line = geometry->segments[index].asLine()) {
             spdlog::trace("Center line selected");
-            Line lineTransformed = *dynamic_cast<Line*>(line->transform(transformations).get());
+            const Transform& composed = transformations.composed();
+            Line lineTransformed(composed.apply(line->p1), composed.apply(line->p2));
             double phiInv = std::atan2(lineTransformed.p2.y - lineTransformed.p1.y, lineTransformed.p2.x - lineTransformed.p1.x);
             Transform t = Transform::rotate(-phiInv);
             Point p1Transformed = lineTransformed.p1.apply(t);
             t.translation[1] = -p1Transformed.y;
-            transformations.push_back(t);
+            transformations.push(t);
             updateGeometryPreview();
             dialog->deactivateCenterLineSelection();
             state = IDLE;
@@ -147,7 +334,7 @@ void DXFImportPresenter::segmentSelected(size_t index) {
 void DXFImportPresenter::pointSelected(const Point& point) {
     if (state == ZERO_POINT_SELECTION) {
         const Transform t = Transform::translate(-point.x, -point.y);
-        transformations.push_back(t);
+        transformations.push(t);
         updateGeometryPreview();
         dialog->deactivateZeroPointSelection();
         state = IDLE;
@@ -156,25 +343,25 @@ void DXFImportPresenter::pointSelected(const Point& point) {
 
 void DXFImportPresenter::onRotateCW() {
     spdlog::trace("Rotating geometry 90 degrees clockwise");
-    transformations.push_back(Transform::rotate(-M_PI_2));
+    transformations.push(Transform::rotate(-M_PI_2));
     updateGeometryPreview();
 }
 
 void DXFImportPresenter::onRotateCCW() {
     spdlog::trace("Rotating geometry 90 degrees counter-clockwise");
-    transformations.push_back(Transform::rotate(M_PI_2));
+    transformations.push(Transform::rotate(M_PI_2));
     updateGeometryPreview();
 }
 
 void DXFImportPresenter::onMirrorX() {
     spdlog::trace("Mirroring geometry along X-axis");
-    transformations.push_back(Transform::mirrorY());
+    transformations.push(Transform::mirrorY());
     updateGeometryPreview();
 }
 
 void DXFImportPresenter::onMirrorZ() {
     spdlog::trace("Mirroring geometry along Z-axis");
-    transformations.push_back(Transform::mirrorX());
+    transformations.push(Transform::mirrorX());
     updateGeometryPreview();
 }
 
@@ -182,7 +369,7 @@ void DXFImportPresenter::onAxialOffsetChanged(double offset) {
     spdlog::trace("Applying axial offset of {} mm", offset);
     const double delta = offset - previousAxialOffset;
     const Transform t = Transform::translate(0.0, delta);
-    transformations.push_back(t);
+    transformations.push(t);
     previousAxialOffset = offset;
     updateGeometryPreview();
 }
@@ -191,7 +378,7 @@ void DXFImportPresenter::onRadialOffsetChanged(double offset) {
     spdlog::trace("Applying radial offset of {} mm", offset);
     const double delta = offset - previousRadialOffest;
     const Transform t = Transform::translate(delta, 0.0);
-    transformations.push_back(t);
+    transformations.push(t);
     previousRadialOffest = offset;
     updateGeometryPreview();
 }
@@ -203,36 +390,12 @@ void DXFImportPresenter::onUnitsChanged(const QString& units) {
         return; // No change needed
     }
 
-    double scaleFactor = 1.0;
-
-    // Calculate scale factor for conversion
-    // Convert to mm as base unit, then to target unit
-    double fromMmToBase = 1.0; // Factor from mm to current unit
-    double toMmFromTarget = 1.0; // Factor from target unit to mm
-
-    // Convert previous unit to mm factor
-    if (previousUnits == "mm") {
-        fromMmToBase = 1.0;
-    } else if (previousUnits == "m") {
-        fromMmToBase = 1000.0; // 1 m = 1000 mm
-    } else if (previousUnits == "inch") {
-        fromMmToBase = 25.4; // 1 inch = 25.4 mm
-    }
-
-    // Convert target unit from mm factor
-    if (units == "mm") {
-        toMmFromTarget = 1.0;
-    } else if (units == "m") {
-        toMmFromTarget = 1000.0; // 1 m = 1000 mm
-    } else if (units == "inch") {
-        toMmFromTarget = 25.4; // 1 inch = 25.4 mm
-    }
-
-    scaleFactor = fromMmToBase / toMmFromTarget;
+    // Convert through mm as the base unit
+    const double scaleFactor = millimetersPerUnit(previousUnits) / millimetersPerUnit(units);
 
     if (scaleFactor != 1.0) {
         spdlog::trace("Applying scale factor {} for units conversion", scaleFactor);
-        transformations.push_back(Transform::scale(scaleFactor, scaleFactor));
+        transformations.push(Transform::scale(scaleFactor, scaleFactor));
         updateGeometryPreview();
     }
 
@@ -270,16 +433,14 @@ void DXFImportPresenter::onNextStageRequested() {
         double minPos = INFINITY;
         double maxPos = -INFINITY;
         double radius = 0.0;
-        Geometry transformedGeometry = geometry->transform(transformations);
-        for (const auto& segment : transformedGeometry.segments) {
-            if (Line* line = dynamic_cast<Line*>(segment.get())) {
-                minPos = std::min(minPos, line->p1.x);
-                minPos = std::min(minPos, line->p2.x);
-                maxPos = std::max(maxPos, line->p1.x);
-                maxPos = std::max(maxPos, line->p2.x);
-                radius = std::max(radius, line->p1.y);
-                radius = std::max(radius, line->p2.y);
-            }
+        const Geometry transformedGeometry = geometry->transform(transformations.composed());
+        const SegmentStore& segments = transformedGeometry.segments;
+        for (size_t i = 0; i < segments.size(); i++) {
+            // Arc bounds include the parts bulging past their endpoints
+            const BoundingBox box = segments.bounds(i);
+            minPos = std::min(minPos, box.minX);
+            maxPos = std::max(maxPos, box.maxX);
+            radius = std::max(radius, box.maxY);
         }
         stockMaterial.startPosition = minPos;
         stockMaterial.endPosition = maxPos;
@@ -301,5 +462,6 @@ void DXFImportPresenter::onImportAccepted() {
 }
 
 void DXFImportPresenter::onImportCancelled() {
+    cancelImport();
     emit importCancelled();
 }
\ No newline at end of file
@@ -6,15 +6,24 @@
 #define TURNLAB_DXFIMPORTPRESENTER_H
 
 #include <QString>
+#include <QThread>
+#include <atomic>
 #include <memory>
 #include <optional>
+#include <vector>
 
-#include "Transform.h"
+#include "TransformStack.h"
 #include "../model/MachineConfig.h"
 #include "../model/Project.h"
 #include "../view/DXFImportDialog.h"
 #include "../model/geometry/Geometry.h"
 #include "../model/StockMaterial.h"
+#include "../utils/DXFStreamReader.h"
+#include "GeometryCleanup.h"
+#include "Simplify.h"
+
+// Minimum time between partial previews while a DXF file loads, in milliseconds
+#define DXF_PREVIEW_INTERVAL_MS 100
 
 enum State {
     CENTER_LINE_SELECTION,
@@ -32,7 +41,7 @@ private:
 
     State state = IDLE;
 
-    std::vector<Transform> transformations;
+    TransformStack transformations;
 
     double previousAxialOffset = 0;
     double previousRadialOffest = 0;
@@ -40,13 +49,39 @@ private:
 
     StockMaterial stockMaterial = {-10.0, 100.0, 25.0};
 
+    // File being imported, reloaded with new options when the layer selection changes
+    QString dxfFilePath;
+    DXFImportOptions importOptions;
+    std::vector<DXFLayerStatistics> layerStatistics;
+    // Cleaned up import before simplification, each simplification starts from it
+    Geometry importedGeometry;
+
+    // Outcome of a background import
+    struct ImportResult {
+        Geometry imported;
+        SimplifyResult simplified;
+        // Counts only, the cleaned segments are in imported
+        CleanupResult cleanup;
+    };
+
+    // Background DXF import, the worker polls importCancelRequested between entities.
+    // Results posted by the worker of an earlier load carry an older importGeneration and are ignored.
+    std::unique_ptr<QThread> importThread;
+    std::atomic<bool> importCancelRequested = false;
+    uint64_t importGeneration = 0;
+
     void connectSignals();
+    void cancelImport();
+    void onImportProgress(uint64_t generation, const DXFStreamStatistics& statistics, qint64 totalBytes, const SegmentStore& newSegments);
+    void onLayersScanned(uint64_t generation, const std::vector<DXFLayerStatistics>& layers);
+    void onImportFinished(uint64_t generation, const std::shared_ptr<ImportResult>& result, const QString& error);
+    void showSimplifySummary(const SimplifyResult& result);
     void updateGeometryPreview();
     void updateStockPreview();
 
 public:
     explicit DXFImportPresenter(const std::string& dxfFilePath, const MachineConfig& config, QWidget* parent = nullptr);
-    ~DXFImportPresenter() = default;
+    ~DXFImportPresenter() override;
     
     // Show the dialog and return the configuration result
     std::optional<Project> showDialog() const;
@@ -54,7 +89,8 @@ public:
     // Set geom to preview
     void setGeometry(const Geometry& geom);
     
-    // Load DXF file for preview
+    // Start loading a DXF file on a worker thread, the preview fills in as segments are read.
+    // Returns false if the file can't be read.
     bool loadDXFFile(const QString& filePath);
 
 private slots:
@@ -71,6 +107,8 @@ private slots:
     void onAxialOffsetChanged(double offset);
     void onRadialOffsetChanged(double offset);
     void onUnitsChanged(const QString& units);
+    void onLayerSelectionChanged(const QStringList& keptLayers);
+    void onSimplifyRequested(double tolerance);
 
     void onStockStartOffsetChanged(double offset);
     void onStockEndOffsetChanged(double offset);
@@ -83,6 +121,7 @@ private slots:
     void onImportCancelled();
 
 signals:
+    void importProgress(qint64 bytesRead, qint64 totalBytes, qint64 entities);
     void importConfigured();
     void importCancelled();
 };
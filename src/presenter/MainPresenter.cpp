@@ -5,6 +5,7 @@
 #include "postprocessor/PythonPostProcessor.h"
 #include "MainPresenter.h"
 
+#include <QCoreApplication>
 #include <QFileDialog>
 #include <spdlog/spdlog.h>
 #include <fstream>
@@ -12,13 +13,17 @@
 #include "MachineConfigPresenter.h"
 #include "ProjectUtils.h"
 #include "../utils/ConfigurationManager.h"
+#include "operation/ContouringOperationPresenter.h"
 #include "operation/FacingOperationPresenter.h"
 #include "operation/PartingOperationPresenter.h"
 #include "operation/TurningOperationPresenter.h"
 #include "tool/table/ToolTablePresenter.h"
 #include "toolpath/ToolpathGenerator.h"
 
-MainPresenter::MainPresenter() : machineConfig(ConfigurationManager::loadMachineConfig()), toolTable(ConfigurationManager::loadToolTable()), window(machineConfig, toolTable), toolpathPlotter(window.getGeometryView()) {
+MainPresenter::MainPresenter() : machineConfig(ConfigurationManager::loadMachineConfig()), toolTable(ConfigurationManager::loadToolTable()), window(machineConfig, toolTable), toolpathPlotter(window.getGeometryView()),
+                                 toolpathCache(DEFAULT_TOOLPATH_CACHE_ENTRIES, ConfigurationManager::getCacheDirectory() / "toolpaths") {
+    previewTimer.setSingleShot(true);
+    previewTimer.setInterval(PREVIEW_DEBOUNCE_MS);
     window.show();
     connectSignals();
 }
@@ -31,6 +36,12 @@ MainPresenter::MainPresenter(Project project) : MainPresenter() {
     setProject(project);
 }
 
+MainPresenter::~MainPresenter() {
+    // Jobs only touch their own copies, but post back to this presenter
+    toolpathPool.clear();
+    toolpathPool.waitForDone();
+}
+
 void MainPresenter::connectSignals() {
     connect(&window, &MainWindow::onMachineConfigPressed, this, &MainPresenter::showMachineConfigDialog);
     connect(&window, &MainWindow::onToolTablePressed, this, &MainPresenter::showToolTableDialog);
@@ -39,12 +50,15 @@ void MainPresenter::connectSignals() {
 
     connect(&window, &MainWindow::onFacingPressed, this, &MainPresenter::onFacingPressed);
     connect(&window, &MainWindow::onTurningPressed, this, &MainPresenter::onTurningPressed);
+    connect(&window, &MainWindow::onContouringPressed, this, &MainPresenter::onContouringPressed);
     connect(&window, &MainWindow::onPartingPressed, this, &MainPresenter::onPartingPressed);
 
     connect(&window, &MainWindow::onGenerateGCodePressed, this, &MainPresenter::onGenerateGCodePressed);
 
     connect(&window.getLeftPanel(), &LeftPanel::operationDeleteRequested, this, &MainPresenter::onOperationDeleteRequested);
     connect(&window.getLeftPanel(), &LeftPanel::operationEditRequested, this, &MainPresenter::onOperationEditRequested);
+
+    connect(&previewTimer, &QTimer::timeout, this, &MainPresenter::startPreview);
 }
 
 void MainPresenter::showDXFImportDialog(std::string inputDXF) {
@@ -65,9 +79,62 @@ void MainPresenter::showCurrentOperation() {
     // Connect OK and Cancel button signals
     connect(currentOpConfigView.get(), &OperationConfigurationView::okPressed, this, &MainPresenter::onOperationConfigOkPressed);
     connect(currentOpConfigView.get(), &OperationConfigurationView::cancelPressed, this, &MainPresenter::onOperationConfigCancelPressed);
+    // Restarting the timer on every change coalesces bursts such as spinbox ticks
+    connect(currentOpConfigPresenter.get(), &OperationConfigurationPresenter::configurationChanged, &previewTimer, qOverload<>(&QTimer::start));
 
     window.replaceLeftPanel(currentOpConfigView.get());
     window.disableOperationButtons();
+
+    if (editingOperationIndex.has_value()) {
+        finishToolpathGeneration();
+        toolpathPlotter.plotToolpaths(toolpaths, editingOperationIndex);
+        previewTimer.start();
+    }
+}
+
+void MainPresenter::startPreview() {
+    if (!currentOpConfigPresenter) {
+        return;
+    }
+
+    if (previewRunning) {
+        previewRequested = true;
+        return;
+    }
+
+    previewRunning = true;
+    const uint64_t generation = ++previewGeneration;
+    toolpathPool.start([this, generation, operation = currentOpConfigPresenter->getOperationConfiguration(), config = machineConfig, geometry = projectGeometry] {
+        // Intermediate configurations are not worth caching
+        auto toolpath = std::make_shared<TToolpathSequence>(ToolpathGenerator::generateToolpath(operation, config, *geometry));
+        QMetaObject::invokeMethod(this, [this, generation, toolpath] {
+            onPreviewGenerated(generation, toolpath);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainPresenter::onPreviewGenerated(const uint64_t generation, const std::shared_ptr<TToolpathSequence>& toolpath) {
+    previewRunning = false;
+    if (previewRequested) {
+        // The configuration changed while this one was generated
+        previewRequested = false;
+        startPreview();
+        return;
+    }
+    // Editing has ended or restarted
+    if (generation != previewGeneration || !currentOpConfigPresenter) {
+        return;
+    }
+    toolpathPlotter.plotPreview(*toolpath);
+    showCycleTime(CycleTimeEstimator(machineConfig).estimate(*toolpath));
+}
+
+void MainPresenter::stopPreview() {
+    previewTimer.stop();
+    ++previewGeneration;
+    previewRequested = false;
+    toolpathPlotter.clearPreview();
+    showCycleTime();
 }
 
 void MainPresenter::onFacingPressed() {
@@ -86,6 +153,14 @@ void MainPresenter::onTurningPressed() {
     showCurrentOperation();
 }
 
+void MainPresenter::onContouringPressed() {
+    spdlog::info("Contouring pressed");
+    currentOpConfigView = std::make_unique<OperationConfigurationView>(ContouringOperationPresenter::visibility);
+    currentOpConfigPresenter = std::make_unique<ContouringOperationPresenter>(machineConfig, toolTable, *project, window.getGeometryView(), *currentOpConfigView);
+
+    showCurrentOperation();
+}
+
 void MainPresenter::onPartingPressed() {
     spdlog::info("Parting pressed");
     currentOpConfigView = std::make_unique<OperationConfigurationView>(PartingOperationPresenter::visibility);
@@ -107,6 +182,8 @@ void MainPresenter::onOperationDeleteRequested(int index) {
         return;
     }
 
+    finishToolpathGeneration();
+
     // Remove operation from project
     project->operations.erase(project->operations.begin() + index);
 
@@ -119,6 +196,8 @@ void MainPresenter::onOperationDeleteRequested(int index) {
     saveProject(*project, project->savePath);
     window.setProject(*project);
     toolpathPlotter.plotToolpaths(toolpaths);
+    // The operation list was rebuilt and its times shifted
+    updateCycleTimes();
 
     spdlog::info("Operation deleted successfully");
 }
@@ -155,6 +234,12 @@ void MainPresenter::onOperationEditRequested(int index) {
             currentOpConfigPresenter = std::make_unique<TurningOperationPresenter>(machineConfig, toolTable, *project, window.getGeometryView(), *currentOpConfigView);
             break;
 
+        case OperationType::Contouring:
+            spdlog::info("Editing contouring operation");
+            currentOpConfigView = std::make_unique<OperationConfigurationView>(ContouringOperationPresenter::visibility);
+            currentOpConfigPresenter = std::make_unique<ContouringOperationPresenter>(machineConfig, toolTable, *project, window.getGeometryView(), *currentOpConfigView);
+            break;
+
         case OperationType::Parting:
             spdlog::info("Editing parting operation");
             currentOpConfigView = std::make_unique<OperationConfigurationView>(PartingOperationPresenter::visibility);
@@ -174,15 +259,82 @@ void MainPresenter::onOperationEditRequested(int index) {
 
 void MainPresenter::setProject(Project p) {
     project = std::make_unique<Project>(p);
+    projectGeometry = std::make_shared<const SegmentStore>(project->geometry.segments);
     window.setProject(*project);
     if (!p.savePath.empty()) {
         saveProject(*project, p.savePath);
     }
+    generateToolpaths();
+}
+
+void MainPresenter::generateToolpaths() {
+    const uint64_t generation = ++toolpathGeneration;
+    toolpathPool.clear();
+
     toolpaths.clear();
-    for (const auto& op : p.operations) {
-        toolpaths.push_back(ToolpathGenerator::generateToolpath(op, machineConfig));
+    toolpaths.resize(project->operations.size());
+    toolpathPlotter.clearToolpaths();
+    pendingToolpaths = project->operations.size();
+
+    // Operations are independent given the machine configuration, jobs work on copies. The
+    // geometry is shared between them, it is only read.
+    for (size_t i = 0; i < project->operations.size(); i++) {
+        toolpathPool.start([this, generation, i, operation = project->operations[i], config = machineConfig, geometry = projectGeometry] {
+            auto toolpath = std::make_shared<TToolpathSequence>(toolpathCache.generate(operation, config, *geometry));
+            QMetaObject::invokeMethod(this, [this, generation, i, toolpath] {
+                onToolpathGenerated(generation, i, toolpath);
+            }, Qt::QueuedConnection);
+        });
     }
-    toolpathPlotter.plotToolpaths(toolpaths);
+    if (pendingToolpaths == 0) {
+        updateCycleTimes();
+    }
+}
+
+void MainPresenter::onToolpathGenerated(const uint64_t generation, const size_t index, const std::shared_ptr<TToolpathSequence>& toolpath) {
+    if (generation != toolpathGeneration || index >= toolpaths.size()) {
+        return;
+    }
+
+    toolpaths[index] = std::move(*toolpath);
+    toolpathPlotter.addToolpathSequence(toolpaths[index], index);
+    if (--pendingToolpaths == 0) {
+        spdlog::info("Generated toolpaths for {} operations", toolpaths.size());
+        updateCycleTimes();
+    }
+}
+
+void MainPresenter::updateCycleTimes() {
+    cycleTime = CycleTimeEstimator(machineConfig).estimateProject(toolpaths);
+    for (size_t i = 0; i < cycleTime.operations.size(); i++) {
+        window.getLeftPanel().setOperationCycleTime(static_cast<int>(i), QString::fromStdString(formatCycleTime(cycleTime.operations[i].total())));
+    }
+    spdlog::info("Estimated cycle time {}", formatCycleTime(cycleTime.total.total()));
+    showCycleTime();
+}
+
+void MainPresenter::showCycleTime(const std::optional<CycleTimeEstimate> preview) {
+    if (!preview) {
+        window.setCycleTime(cycleTime.operations.empty() ? QString() : QString("Cycle time: %1").arg(QString::fromStdString(formatCycleTime(cycleTime.total.total()))));
+        return;
+    }
+
+    // The operation being edited is replaced by its preview
+    double total = cycleTime.total.total() + preview->total();
+    if (editingOperationIndex && *editingOperationIndex < static_cast<int>(cycleTime.operations.size())) {
+        total -= cycleTime.operations[*editingOperationIndex].total();
+    }
+    window.setCycleTime(QString("Operation: %1  Cycle time: %2").arg(QString::fromStdString(formatCycleTime(preview->total())),
+                                                                      QString::fromStdString(formatCycleTime(total))));
+}
+
+void MainPresenter::finishToolpathGeneration() {
+    if (pendingToolpaths == 0) {
+        return;
+    }
+    // Callers index into toolpaths, so every pending result has to be in place first
+    toolpathPool.waitForDone();
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
 }
 
 void MainPresenter::showMachineConfigDialog() {
@@ -193,6 +345,9 @@ void MainPresenter::showMachineConfigDialog() {
     // Save the updated configuration
     machineConfig = updatedConfig;
     ConfigurationManager::saveMachineConfig(machineConfig);
+    if (pendingToolpaths == 0) {
+        updateCycleTimes();
+    }
     spdlog::info("Machine configuration updated and saved");
 }
 
@@ -211,6 +366,8 @@ void MainPresenter::onOperationConfigOkPressed() {
     spdlog::info("Operation configuration OK pressed");
 
     const auto& newConfig = currentOpConfigPresenter->getOperationConfiguration();
+    finishToolpathGeneration();
+    stopPreview();
 
     if (editingOperationIndex.has_value()) {
         // Edit mode: replace existing operation
@@ -218,7 +375,7 @@ void MainPresenter::onOperationConfigOkPressed() {
         spdlog::info("Updating operation at index: {}", index);
 
         project->operations[index] = newConfig;
-        toolpaths[index] = ToolpathGenerator::generateToolpath(newConfig, machineConfig);
+        toolpaths[index] = toolpathCache.generate(newConfig, machineConfig, project->geometry.segments);
 
         editingOperationIndex.reset();
     } else {
@@ -226,13 +383,14 @@ void MainPresenter::onOperationConfigOkPressed() {
         spdlog::info("Adding new operation");
 
         project->operations.push_back(newConfig);
-        toolpaths.push_back(ToolpathGenerator::generateToolpath(newConfig, machineConfig));
+        toolpaths.push_back(toolpathCache.generate(newConfig, machineConfig, project->geometry.segments));
     }
 
     // Save and update UI
     saveProject(*project, project->savePath);
     window.setProject(*project);
     toolpathPlotter.plotToolpaths(toolpaths);
+    updateCycleTimes();
 
     window.restoreLeftPanel();
     window.enableOperationButtons();
@@ -245,36 +403,44 @@ void MainPresenter::onOperationConfigOkPressed() {
 void MainPresenter::onGenerateGCodePressed() {
     spdlog::info("Generate GCode button pressed");
 
-    if (!project || toolpaths.empty()) {
-        spdlog::warn("No project or toolpaths available for GCode generation");
+    if (!project || project->operations.empty()) {
+        spdlog::warn("No project or operations available for GCode generation");
+        return;
+    }
+
+    // Show save dialog to user
+    QString fileName = QFileDialog::getSaveFileName(
+        &window,
+        "Save NC File",
+        QString(),
+        "NC Files (*.nc)"
+    );
+    if (fileName.isEmpty()) {
         return;
     }
 
     try {
+        std::ofstream file(fileName.toStdString());
+        if (!file.is_open()) {
+            spdlog::error("Failed to save GCode file: {}", fileName.toStdString());
+            return;
+        }
+
+        // Moves are generated as they are posted and written out directly, so neither the
+        // toolpaths nor the G-code are held in memory in full
+        std::vector<TMoveStream> streams;
+        streams.reserve(project->operations.size());
+        for (const auto& operation : project->operations) {
+            streams.push_back(ToolpathGenerator::streamToolpath(operation, machineConfig, *projectGeometry));
+        }
+
         PythonPostProcessor postProcessor(machineConfig, toolTable);
-        std::string gcode = postProcessor.generateGCode(toolpaths);
-
-        if (!gcode.empty()) {
-            // Show save dialog to user
-            QString fileName = QFileDialog::getSaveFileName(
-                &window,
-                "Save NC File",
-                QString(),
-                "NC Files (*.nc)"
-            );
-
-            if (!fileName.isEmpty()) {
-                std::ofstream file(fileName.toStdString());
-                if (file.is_open()) {
-                    file << gcode;
-                    file.close();
-                    spdlog::info("GCode saved to: {}", fileName.toStdString());
-                } else {
-                    spdlog::error("Failed to save GCode file: {}", fileName.toStdString());
-                }
-            }
+        if (postProcessor.generateGCode(std::move(streams), file)) {
+            spdlog::info("GCode saved to: {}", fileName.toStdString());
         } else {
-            spdlog::warn("Generated GCode is empty");
+            file.close();
+            std::filesystem::remove(fileName.toStdString());
+            spdlog::error("Failed to generate GCode, {} was not written", fileName.toStdString());
         }
 
     } catch (const std::exception& e) {
@@ -285,6 +451,12 @@ void MainPresenter::onGenerateGCodePressed() {
 void MainPresenter::onOperationConfigCancelPressed() {
     spdlog::info("Operation configuration Cancel pressed");
 
+    stopPreview();
+    // The edited operation's toolpath was hidden during the preview
+    if (editingOperationIndex.has_value()) {
+        toolpathPlotter.plotToolpaths(toolpaths);
+    }
+
     // Reset edit mode if active
     editingOperationIndex.reset();
 
@@ -7,6 +7,9 @@
 
 #include <string>
 #include <filesystem>
+#include <memory>
+#include <QThreadPool>
+#include <QTimer>
 
 #include "../view/MainWindow.h"
 #include "DXFImportPresenter.h"
@@ -14,8 +17,13 @@
 #include "../model/MachineConfig.h"
 #include "../model/toolpath/TToolpathSequence.h"
 #include "../view/ToolpathPlotter.h"
+#include "../utils/toolpath/CycleTimeEstimator.h"
+#include "../utils/toolpath/ToolpathCache.h"
 
 
+// Quiet time after the last configuration change before the preview is regenerated
+#define PREVIEW_DEBOUNCE_MS 50
+
 class MainPresenter : public QObject {
     Q_OBJECT
 
@@ -25,6 +33,9 @@ class MainPresenter : public QObject {
     MainWindow window;
 
     std::unique_ptr<Project> project;
+    // Copy of the project geometry shared with generation jobs, taken once per project as the
+    // geometry does not change while operations are edited
+    std::shared_ptr<const SegmentStore> projectGeometry;
 
     std::unique_ptr<OperationConfigurationView> currentOpConfigView;
     std::unique_ptr<OperationConfigurationPresenter> currentOpConfigPresenter;
@@ -35,6 +46,39 @@ class MainPresenter : public QObject {
 
     ToolpathPlotter toolpathPlotter;
 
+    // Only operations whose configuration changed are regenerated
+    ToolpathCache toolpathCache;
+
+    // Toolpaths of a project are generated in parallel, each result is posted back to the GUI thread
+    // and plotted as it arrives. Results of an earlier project carry an older toolpathGeneration and
+    // are ignored.
+    QThreadPool toolpathPool;
+    uint64_t toolpathGeneration = 0;
+    size_t pendingToolpaths = 0;
+
+    void generateToolpaths();
+    void onToolpathGenerated(uint64_t generation, size_t index, const std::shared_ptr<TToolpathSequence>& toolpath);
+    void finishToolpathGeneration();
+
+    // Estimated once all toolpaths of the project are in, shown per operation and in the status bar
+    ProjectCycleTime cycleTime;
+
+    void updateCycleTimes();
+    void showCycleTime(std::optional<CycleTimeEstimate> preview = std::nullopt);
+
+    // Live preview of the operation being configured. Bursts of changes restart previewTimer, the
+    // toolpath is generated on toolpathPool and results older than previewGeneration are dropped.
+    // At most one preview is generated at a time, changes made meanwhile set previewRequested and
+    // are previewed with the latest configuration once it finishes.
+    QTimer previewTimer;
+    uint64_t previewGeneration = 0;
+    bool previewRunning = false;
+    bool previewRequested = false;
+
+    void startPreview();
+    void onPreviewGenerated(uint64_t generation, const std::shared_ptr<TToolpathSequence>& toolpath);
+    void stopPreview();
+
     void connectSignals();
 
     void showMachineConfigDialog();
@@ -48,6 +92,7 @@ class MainPresenter : public QObject {
 private slots:
     void onFacingPressed();
     void onTurningPressed();
+    void onContouringPressed();
     void onPartingPressed();
 
     void onOperationDeleteRequested(int index);
@@ -61,7 +106,7 @@ public:
     MainPresenter();
     explicit MainPresenter(const std::string &inputDXF);
     explicit MainPresenter(Project project);
-    ~MainPresenter() = default;
+    ~MainPresenter() override;
 
     void setProject(Project p);
 
@@ -75,6 +75,8 @@ void OperationConfigurationPresenter::connectSignals() {
             this, &OperationConfigurationPresenter::onDwellTimeChanged);
     connect(&configView, &OperationConfigurationView::backoffDistanceChanged,
             this, &OperationConfigurationPresenter::onBackoffDistanceChanged);
+    connect(&configView, &OperationConfigurationView::stockAllowanceChanged,
+            this, &OperationConfigurationPresenter::onStockAllowanceChanged);
 
     // Connect geometry view signals
     connect(&geometryView, &GeometryView::segmentSelected,
@@ -224,6 +226,12 @@ void OperationConfigurationPresenter::onBackoffDistanceChanged(double distance)
     emit configurationChanged();
 }
 
+void OperationConfigurationPresenter::onStockAllowanceChanged(double allowance) {
+    spdlog::debug("Stock allowance changed to: {}", allowance);
+    operationConfig.stockAllowance = allowance;
+    emit configurationChanged();
+}
+
 void OperationConfigurationPresenter::onTabChanged(OperationConfigTab tab) {
     switch (tab) {
         case OperationConfigTab::Tool:
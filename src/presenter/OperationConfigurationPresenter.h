@@ -44,6 +44,8 @@ protected:
     OperationConfigurationView& configView;
     OperationConfigurationPlotHelper plotHelper;
 
+    bool isGeometrySelectionEnabled() const { return geometrySelectionEnabled; }
+
 signals:
     void configurationChanged();
 
@@ -69,6 +71,7 @@ protected slots:
     void onPeckDepthChanged(double depth);
     void onDwellTimeChanged(int time);
     void onBackoffDistanceChanged(double distance);
+    void onStockAllowanceChanged(double allowance);
 
 public:
     explicit OperationConfigurationPresenter(
@@ -0,0 +1,9 @@
+//
+// Configuration of contouring operations, which follow a chain of selected segments.
+//
+
+#include "ContouringOperationPresenter.h"
+
+ContouringOperationPresenter::ContouringOperationPresenter(const MachineConfig &machineConfig, const ToolTable &toolTable, const Project &project, GeometryView &geometryView, OperationConfigurationView &operationConfigView, QObject *parent) : OperationConfigurationPresenter(visibility, machineConfig, toolTable, project, geometryView, operationConfigView, parent) {
+    operationConfig.operationType = OperationType::Contouring;
+}
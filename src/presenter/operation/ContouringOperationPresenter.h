@@ -0,0 +1,48 @@
+//
+// Configuration of contouring operations, which follow a chain of selected segments.
+//
+
+#ifndef TURNLAB_CONTOURINGOPERATIONPRESENTER_H
+#define TURNLAB_CONTOURINGOPERATIONPRESENTER_H
+#include <QObject>
+
+#include "../OperationConfigurationPresenter.h"
+
+
+class ContouringOperationPresenter : public OperationConfigurationPresenter {
+
+public:
+    explicit ContouringOperationPresenter(
+        const MachineConfig& machineConfig,
+        const ToolTable& toolTable,
+        const Project& project,
+        GeometryView& geometryView,
+        OperationConfigurationView& operationConfigView,
+        QObject* parent = nullptr
+    );
+
+
+    // Segments are followed in the order they are selected
+    static constexpr OperationConfigVisibility visibility = {
+        .showToolSelector = true,
+        .showRpmInput = true,
+        .showFeedrateInput = true,
+
+        .showGeometrySelection = true,
+
+        .showRetractDistance = true,
+        .showClearanceDistance = true,
+        .showFeedDistance = true,
+
+        .showSpringPasses = true,
+        .showStockAllowance = true,
+
+        .showToolTab = true,
+        .showGeometryTab = true,
+        .showRadiiTab = true,
+        .showPassesTab = true,
+    };
+};
+
+
+#endif //TURNLAB_CONTOURINGOPERATIONPRESENTER_H
@@ -16,7 +16,7 @@ FacingOperationPresenter::FacingOperationPresenter(const MachineConfig &machineC
 
 void FacingOperationPresenter::onSegmentSelected(size_t segmentIndex) {
     // first check if it is a line, then check if it is vertical, if not return
-    if (auto line = dynamic_cast<Line*>(project.geometry.segments[segmentIndex].get())) {
+    if (const auto line = project.geometry.segments[segmentIndex].asLine()) {
         if (!line->isVertical()) {
             spdlog::warn("Facing operation requires a vertical line segment. Selected segment is not vertical.");
             return;
@@ -14,7 +14,7 @@ PartingOperationPresenter::PartingOperationPresenter(const MachineConfig &machin
 
 void PartingOperationPresenter::onSegmentSelected(size_t segmentIndex) {
     // first check if it is a line, then check if it is vertical, if not return
-    if (auto line = dynamic_cast<Line*>(project.geometry.segments[segmentIndex].get())) {
+    if (const auto line = project.geometry.segments[segmentIndex].asLine()) {
         if (!line->isVertical()) {
             spdlog::warn("Parting operation requires a vertical line segment. Selected segment is not vertical.");
             return;
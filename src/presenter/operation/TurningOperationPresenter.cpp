@@ -4,9 +4,11 @@
 
 #include "TurningOperationPresenter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <spdlog/spdlog.h>
-#include "GeometryUtils.h"
-#include "../model/geometry/Line.h"
+#include "toolpath/Contour.h"
 
 TurningOperationPresenter::TurningOperationPresenter(const MachineConfig &machineConfig, const ToolTable &toolTable, const Project &project, GeometryView &geometryView, OperationConfigurationView &operationConfigView, QWidget *parent)
     : OperationConfigurationPresenter(visibility, machineConfig, toolTable, project, geometryView, operationConfigView, parent) {
@@ -14,27 +16,42 @@ TurningOperationPresenter::TurningOperationPresenter(const MachineConfig &machin
 }
 
 void TurningOperationPresenter::onSegmentSelected(size_t segmentIndex) {
-    if (auto line = dynamic_cast<Line*>(project.geometry.segments[segmentIndex].get())) {
-        if (!line->isHorizontal()) {
-            spdlog::warn("Facing operation requires a vertical line segment. Selected segment is not vertical.");
+    const auto& selection = operationConfig.geometrySelection;
+    if (!isGeometrySelectionEnabled() || std::find(selection.begin(), selection.end(), segmentIndex) != selection.end()) {
+        return;
+    }
+
+    std::vector<size_t> chain = selection;
+    chain.push_back(segmentIndex);
+    Contour profile;
+    try {
+        profile = buildContour(project.geometry.segments, chain);
+    } catch (const std::invalid_argument& e) {
+        // A segment that does not continue the profile starts a new one
+        spdlog::info("Starting a new turning profile: {}", e.what());
+        try {
+            profile = buildContour(project.geometry.segments, {segmentIndex});
+        } catch (const std::invalid_argument& error) {
+            spdlog::warn("Turning operation requires a line or arc segment: {}", error.what());
             return;
         }
-        OperationConfigurationPresenter::onSegmentSelected(segmentIndex);
-
-        auto [chuckP, tailStockP] = GeometryUtils::getChuckAndTailstockPoint(*line, machineConfig);
-
-        operationConfig.axialStartPosition = tailStockP.x;
-        operationConfig.axialEndPosition = chuckP.x;
-
-        operationConfig.innerDistance = chuckP.y;
-        operationConfig.outerDistance = machineConfig.xAxisDirection == AxisDirection::Positive ? project.stockMaterial.radius : -project.stockMaterial.radius;
-
-        configView.setOperationConfiguration(operationConfig);
-        plotHelper.update();
-        configView.update();
-
-    } else {
-        spdlog::warn("Facing operation requires a line segment. Selected segment is not a line.");
-        return;
+        operationConfig.geometrySelection.clear();
     }
+    OperationConfigurationPresenter::onSegmentSelected(segmentIndex);
+
+    orientTowardsChuck(profile, machineConfig.zAxisDirection);
+    operationConfig.axialStartPosition = profile.front().start.z;
+    operationConfig.axialEndPosition = profile.back().end.z;
+
+    // Passes go down to the point of the profile closest to the centerline
+    const std::vector<TPoint> points = flattenContour(profile);
+    const auto innermost = std::min_element(points.begin(), points.end(), [](const TPoint& a, const TPoint& b) {
+        return std::abs(a.x) < std::abs(b.x);
+    });
+    operationConfig.innerDistance = innermost->x;
+    operationConfig.outerDistance = machineConfig.xAxisDirection == AxisDirection::Positive ? project.stockMaterial.radius : -project.stockMaterial.radius;
+
+    configView.setOperationConfiguration(operationConfig);
+    plotHelper.update();
+    configView.update();
 }
@@ -21,13 +21,13 @@ public:
         QWidget* parent = nullptr
     );
 
+    // Segments are chained into the profile the passes rough down to, in the order they are selected
     static constexpr OperationConfigVisibility visibility = {
         .showToolSelector = true,
         .showRpmInput = true,
         .showFeedrateInput = true,
 
         .showGeometrySelection = true,
-        .singleSegmentSelection = true,
         .showAxialStartOffset = true,
         .showAxialEndOffset = true,
 
@@ -38,6 +38,7 @@ public:
         .showInnerDistance = true,
 
         .showStepover = true,
+        .showStockAllowance = true,
 
         .showToolTab = true,
         .showGeometryTab = true,
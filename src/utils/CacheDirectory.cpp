@@ -0,0 +1,81 @@
+//
+// Shared handling of on-disk cache directories.
+//
+
+#include "CacheDirectory.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+void touchCacheEntry(const std::filesystem::path& path) {
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+}
+
+bool writeCacheEntry(const std::filesystem::path& path, const std::function<void(std::ostream&)>& write) {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    try {
+        std::filesystem::create_directories(path.parent_path());
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                spdlog::warn("Failed to open cache file: {}", temporary.string());
+                return false;
+            }
+            write(file);
+            if (!file) {
+                throw std::runtime_error("write failed");
+            }
+        }
+        std::filesystem::rename(temporary, path);
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to store cache entry {}: {}", path.string(), e.what());
+        std::error_code error;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+void evictCacheEntries(const std::filesystem::path& directory, const std::string_view extension, const uint64_t maxBytes) {
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUsed;
+        uint64_t size;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(directory, error)) {
+        if (!item.is_regular_file(error) || item.path().extension() != extension) {
+            continue;
+        }
+        const uint64_t size = item.file_size(error);
+        const auto lastUsed = item.last_write_time(error);
+        if (error) {
+            continue;
+        }
+        entries.push_back({item.path(), lastUsed, size});
+        total += size;
+    }
+    if (total <= maxBytes) {
+        return;
+    }
+
+    std::ranges::sort(entries, {}, &Entry::lastUsed);
+    for (const Entry& entry : entries) {
+        if (total <= maxBytes) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, error)) {
+            spdlog::debug("Evicted cache entry {}", entry.path.string());
+            total -= entry.size;
+        }
+    }
+}
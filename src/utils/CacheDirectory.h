@@ -0,0 +1,26 @@
+//
+// Shared handling of on-disk cache directories.
+//
+
+#ifndef TURNLAB_CACHEDIRECTORY_H
+#define TURNLAB_CACHEDIRECTORY_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <string_view>
+
+// Entries are single files, their modification time serves as the last access time
+
+// Marks an entry as recently used
+void touchCacheEntry(const std::filesystem::path& path);
+
+// Writes an entry under a temporary name and renames it, so readers never see a partial entry.
+// Failures are logged and reported as false, caches are only an optimization.
+bool writeCacheEntry(const std::filesystem::path& path, const std::function<void(std::ostream&)>& write);
+
+// Removes entries with the given extension least recently used first until the directory fits maxBytes
+void evictCacheEntries(const std::filesystem::path& directory, std::string_view extension, uint64_t maxBytes);
+
+#endif //TURNLAB_CACHEDIRECTORY_H
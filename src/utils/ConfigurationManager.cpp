@@ -20,6 +20,12 @@ std::filesystem::path ConfigurationManager::getConfigDirectory() {
     return configPath;
 }
 
+std::filesystem::path ConfigurationManager::getCacheDirectory() {
+    const std::filesystem::path cachePath = getConfigDirectory() / "cache";
+    std::filesystem::create_directories(cachePath);
+    return cachePath;
+}
+
 std::filesystem::path ConfigurationManager::getMachineConfigPath() {
     return getConfigDirectory() / "machine_config.json";
 }
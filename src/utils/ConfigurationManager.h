@@ -15,6 +15,8 @@ public:
     static ToolTable loadToolTable();
     static void saveMachineConfig(const MachineConfig& config);
     static void saveToolTable(const ToolTable& toolTable);
+    // Directory for regenerable data such as imported geometry
+    static std::filesystem::path getCacheDirectory();
 
 private:
     static std::filesystem::path getConfigDirectory();
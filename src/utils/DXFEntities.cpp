@@ -0,0 +1,87 @@
+//
+// Conversion of DXF entity data into segments, shared by the DXF readers.
+//
+
+#include "DXFEntities.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+#include "../model/geometry/Arc.h"
+#include "../model/geometry/Spline.h"
+#include "Hash.h"
+
+bool DXFImportOptions::keepsLayer(const std::string_view layer) const {
+    return layers.empty() || std::ranges::find(layers, layer) != layers.end();
+}
+
+bool DXFImportOptions::keepsEntityType(const std::string_view type) const {
+    return entityTypes.empty() || std::ranges::find(entityTypes, type) != entityTypes.end();
+}
+
+uint64_t DXFImportOptions::hash() const {
+    // Sorted, so the order the names were listed in doesn't matter
+    const auto hashNames = [](std::vector<std::string> names, uint64_t seed) {
+        std::ranges::sort(names);
+        seed = hashCombine(seed, names.size());
+        for (const std::string& name : names) {
+            seed = hashCombine(seed, fnv1a(name));
+        }
+        return seed;
+    };
+    uint64_t result = hashNames(layers, FNV_OFFSET_BASIS);
+    result = hashNames(entityTypes, result);
+    return hashCombine(result, std::bit_cast<uint64_t>(splineTolerance));
+}
+
+void addDXFArc(SegmentStore& segments, Point center, const double radius, double startAngle, double endAngle, const double extrusionZ) {
+    if (extrusionZ < 0.0) {
+        center.x = -center.x;
+        const double mirroredStart = M_PI - endAngle;
+        endAngle = M_PI - startAngle;
+        startAngle = mirroredStart;
+    }
+    double sweep = std::fmod(endAngle - startAngle, 2.0 * M_PI);
+    if (sweep <= 0.0) {
+        sweep += 2.0 * M_PI;
+    }
+    if (sweep >= 2.0 * M_PI - 1e-12) {
+        // Full circle, split into two half circles
+        segments.addArc(Arc::fromCenter(center, radius, startAngle, startAngle + M_PI));
+        segments.addArc(Arc::fromCenter(center, radius, startAngle + M_PI, startAngle + 2.0 * M_PI));
+    } else {
+        segments.addArc(Arc::fromCenter(center, radius, startAngle, endAngle));
+    }
+}
+
+void addDXFPolyline(SegmentStore& segments, std::vector<Point> vertices, std::vector<double> bulges, const bool closed, const double extrusionZ) {
+    if (extrusionZ < 0.0) {
+        for (auto& vertex : vertices) {
+            vertex.x = -vertex.x;
+        }
+        for (auto& bulge : bulges) {
+            bulge = -bulge;
+        }
+    }
+    segments.addPolyline(vertices, bulges, closed);
+}
+
+bool addDXFSpline(SegmentStore& segments, const int degree, std::vector<Point> controlPoints, std::vector<double> knots,
+                  std::vector<double> weights, const std::vector<Point>& fitPoints, const double tolerance) {
+    if (controlPoints.empty()) {
+        // Splines defined only by fit points are approximated by their fit polygon
+        segments.addPolyline(fitPoints, {}, false);
+        return true;
+    }
+    try {
+        const Spline spline(degree, std::move(controlPoints), std::move(knots), std::move(weights));
+        segments.addPolyline(spline.tessellate(tolerance), {}, false);
+        return true;
+    } catch (const std::invalid_argument& e) {
+        spdlog::warn("Skipping invalid spline: {}", e.what());
+        return false;
+    }
+}
@@ -0,0 +1,51 @@
+//
+// Conversion of DXF entity data into segments, shared by the DXF readers.
+//
+
+#ifndef TURNLAB_DXFENTITIES_H
+#define TURNLAB_DXFENTITIES_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../model/geometry/Point.h"
+#include "../model/geometry/SegmentStore.h"
+
+// Maximum distance between a spline and the line segments approximating it, in drawing units
+#define DEFAULT_SPLINE_TOLERANCE 0.01
+
+// Bump whenever a change to the readers alters the segments produced for a file,
+// this invalidates the imports cached by GeometryCache
+#define DXF_IMPORTER_VERSION 2
+
+// Restricts an import to some layers and entity types, applied before entities are converted
+struct DXFImportOptions {
+    // Layer names to keep, all layers if empty
+    std::vector<std::string> layers;
+    // Entity type names to keep, e.g. "LINE". All supported types if empty.
+    std::vector<std::string> entityTypes;
+    double splineTolerance = DEFAULT_SPLINE_TOLERANCE;
+
+    bool keepsLayer(std::string_view layer) const;
+    bool keepsEntityType(std::string_view type) const;
+    // Part of the geometry cache key, equal for options producing the same import
+    uint64_t hash() const;
+};
+
+// Entities with a negative extrusion direction (extrusionZ < 0) are drawn mirrored in the
+// XY plane, which flips X and the turning direction of arcs.
+
+// Adds the counter-clockwise arc between two angles in radians, full circles as two half arcs
+void addDXFArc(SegmentStore& segments, Point center, double radius, double startAngle, double endAngle, double extrusionZ);
+
+// Adds polyline vertices, bulges[i] belonging to the segment starting at vertex i
+void addDXFPolyline(SegmentStore& segments, std::vector<Point> vertices, std::vector<double> bulges, bool closed, double extrusionZ);
+
+// Adds the tessellated spline, or its fit polygon if there are no control points.
+// Returns false if the spline definition is invalid.
+bool addDXFSpline(SegmentStore& segments, int degree, std::vector<Point> controlPoints, std::vector<double> knots,
+                  std::vector<double> weights, const std::vector<Point>& fitPoints, double tolerance);
+
+#endif //TURNLAB_DXFENTITIES_H
@@ -0,0 +1,430 @@
+//
+// Single-pass, memory-mapped reader for the ENTITIES section of ASCII DXF files.
+//
+
+#include "DXFStreamReader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+// Entity types this reader converts into segments
+constexpr std::string_view SUPPORTED_TYPES[] = {"LINE", "ARC", "CIRCLE", "LWPOLYLINE", "POLYLINE", "SPLINE"};
+// VERTEX flag of the control points of a spline-fit polyline, only the fitted vertices are kept
+constexpr int SPLINE_FRAME_VERTEX = 16;
+
+double toDouble(std::string_view value) {
+    // from_chars does not accept an explicit plus sign
+    if (value.starts_with('+')) {
+        value.remove_prefix(1);
+    }
+    double result = 0.0;
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (error != std::errc() || end != value.data() + value.size()) {
+        throw std::runtime_error("Invalid number in DXF file: " + std::string(value));
+    }
+    return result;
+}
+
+int toInt(const std::string_view value) {
+    int result = 0;
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (error != std::errc() || end != value.data() + value.size()) {
+        throw std::runtime_error("Invalid integer in DXF file: " + std::string(value));
+    }
+    return result;
+}
+
+// Splits the buffer into group code / value line pairs
+class GroupCodeTokenizer {
+public:
+    explicit GroupCodeTokenizer(const std::string_view data) : data(data) {}
+
+    bool next(int& code, std::string_view& value) {
+        std::string_view codeLine;
+        if (!line(codeLine) || !line(value)) {
+            return false;
+        }
+        code = toInt(codeLine);
+        return true;
+    }
+
+    size_t position() const { return pos; }
+
+private:
+    std::string_view data;
+    size_t pos = 0;
+
+    bool line(std::string_view& out) {
+        if (pos >= data.size()) {
+            return false;
+        }
+        const char* start = data.data() + pos;
+        const auto* newline = static_cast<const char*>(std::memchr(start, '\n', data.size() - pos));
+        const size_t length = newline ? static_cast<size_t>(newline - start) : data.size() - pos;
+        out = trim(std::string_view(start, length));
+        pos += length + 1;
+        return true;
+    }
+};
+
+using GroupPairs = std::vector<std::pair<int, std::string_view>>;
+
+// Value of the first pair with the given code
+std::optional<std::string_view> find(const GroupPairs& pairs, const int code) {
+    for (const auto& [c, value] : pairs) {
+        if (c == code) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+double number(const GroupPairs& pairs, const int code, const double fallback = 0.0) {
+    const auto value = find(pairs, code);
+    return value ? toDouble(*value) : fallback;
+}
+
+// Advances to the first pair of the ENTITIES section, returns false if there is none
+bool skipToEntities(GroupCodeTokenizer& tokenizer) {
+    int code = 0;
+    std::string_view value;
+    while (tokenizer.next(code, value)) {
+        if (code == 0 && value == "SECTION" && tokenizer.next(code, value) && code == 2 && value == "ENTITIES") {
+            return true;
+        }
+    }
+    return false;
+}
+
+// POLYLINE entities collect the following VERTEX entities until SEQEND
+struct PendingPolyline {
+    bool accepted = false;
+    bool closed = false;
+    double extrusionZ = 1.0;
+    std::vector<Point> vertices;
+    std::vector<double> bulges;
+};
+
+}
+
+DXFStreamReader::DXFStreamReader(const std::filesystem::path& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        spdlog::error("Failed to open DXF file: {}", path.string());
+        throw std::runtime_error("Failed to open DXF file");
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to stat DXF file");
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    if (mappingSize > 0) {
+        mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            close(fd);
+            throw std::runtime_error("Failed to map DXF file");
+        }
+        madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+        data = std::string_view(static_cast<const char*>(mapping), mappingSize);
+    }
+    close(fd);
+}
+
+DXFStreamReader DXFStreamReader::fromBuffer(const std::string_view data) {
+    return {BufferTag{}, data};
+}
+
+DXFStreamReader::~DXFStreamReader() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+}
+
+void DXFStreamReader::setOptions(DXFImportOptions importOptions) {
+    options = std::move(importOptions);
+}
+
+void DXFStreamReader::setProgressCallback(DXFProgressCallback callback) {
+    progressCallback = std::move(callback);
+}
+
+DXFStreamStatistics DXFStreamReader::read(SegmentStore& segments) const {
+    if (data.starts_with("AutoCAD Binary DXF")) {
+        throw std::runtime_error("Binary DXF files are not supported");
+    }
+
+    DXFStreamStatistics statistics;
+    GroupCodeTokenizer tokenizer(data);
+    int code = 0;
+    std::string_view value;
+
+    if (!skipToEntities(tokenizer)) {
+        statistics.bytesRead = tokenizer.position();
+        return statistics;
+    }
+
+    const auto reportProgress = [&] {
+        if (progressCallback && !progressCallback(statistics, segments)) {
+            throw DXFImportCancelled();
+        }
+    };
+
+    const auto wantedType = [&](const std::string_view type) {
+        return std::ranges::find(SUPPORTED_TYPES, type) != std::end(SUPPORTED_TYPES) && options.keepsEntityType(type);
+    };
+
+    std::optional<PendingPolyline> polyline;
+    const auto flushPolyline = [&] {
+        if (polyline && polyline->accepted) {
+            addDXFPolyline(segments, std::move(polyline->vertices), std::move(polyline->bulges), polyline->closed, polyline->extrusionZ);
+        }
+        polyline.reset();
+    };
+
+    GroupPairs pairs;
+    bool more = tokenizer.next(code, value);
+    while (more) {
+        if (code != 0) {
+            more = tokenizer.next(code, value);
+            continue;
+        }
+        if (value == "ENDSEC" || value == "EOF") {
+            break;
+        }
+
+        const std::string_view type = value;
+        const bool polylinePart = type == "VERTEX" || type == "SEQEND";
+        bool collect = polylinePart ? polyline && polyline->accepted : wantedType(type);
+
+        // Gather the entity's pairs up to the next entity, dropping them as soon as
+        // the entity turns out to be on an excluded layer. Vertices follow their polyline.
+        pairs.clear();
+        bool layerSeen = polylinePart;
+        while ((more = tokenizer.next(code, value)) && code != 0) {
+            if (!collect) {
+                continue;
+            }
+            if (code == 8 && !layerSeen) {
+                layerSeen = true;
+                if (!options.keepsLayer(value)) {
+                    collect = false;
+                    pairs.clear();
+                    continue;
+                }
+            }
+            pairs.emplace_back(code, value);
+        }
+        if (collect && !layerSeen && !options.keepsLayer("0")) {
+            collect = false;
+        }
+
+        if (polylinePart) {
+            if (type == "SEQEND") {
+                flushPolyline();
+            } else if (collect && !(static_cast<int>(number(pairs, 70)) & SPLINE_FRAME_VERTEX)) {
+                polyline->vertices.emplace_back(number(pairs, 10), number(pairs, 20));
+                polyline->bulges.push_back(number(pairs, 42));
+            }
+            continue;
+        }
+
+        flushPolyline();
+        statistics.entitiesRead++;
+        if (statistics.entitiesRead % DXF_PROGRESS_INTERVAL == 0) {
+            statistics.bytesRead = tokenizer.position();
+            reportProgress();
+        }
+        if (type == "INSERT") {
+            statistics.blockReferences++;
+        }
+        if (!collect) {
+            statistics.entitiesSkipped++;
+            continue;
+        }
+
+        if (type == "LINE") {
+            segments.addLine(number(pairs, 10), number(pairs, 20), number(pairs, 11), number(pairs, 21));
+        } else if (type == "ARC") {
+            addDXFArc(segments, Point(number(pairs, 10), number(pairs, 20)), number(pairs, 40),
+                      number(pairs, 50) * M_PI / 180.0, number(pairs, 51) * M_PI / 180.0, number(pairs, 230, 1.0));
+        } else if (type == "CIRCLE") {
+            addDXFArc(segments, Point(number(pairs, 10), number(pairs, 20)), number(pairs, 40), 0.0, 2.0 * M_PI, number(pairs, 230, 1.0));
+        } else if (type == "LWPOLYLINE") {
+            std::vector<Point> vertices;
+            std::vector<double> bulges;
+            for (const auto& [c, v] : pairs) {
+                if (c == 10) {
+                    vertices.emplace_back(toDouble(v), 0.0);
+                    bulges.push_back(0.0);
+                } else if (c == 20 && !vertices.empty()) {
+                    vertices.back().y = toDouble(v);
+                } else if (c == 42 && !bulges.empty()) {
+                    bulges.back() = toDouble(v);
+                }
+            }
+            addDXFPolyline(segments, std::move(vertices), std::move(bulges), static_cast<int>(number(pairs, 70)) & 1, number(pairs, 230, 1.0));
+        } else if (type == "POLYLINE") {
+            const int flags = static_cast<int>(number(pairs, 70));
+            polyline.emplace();
+            // Polygon and polyface meshes are surfaces, not profiles
+            polyline->accepted = !(flags & (16 | 64));
+            polyline->closed = flags & 1;
+            polyline->extrusionZ = number(pairs, 230, 1.0);
+        } else if (type == "SPLINE") {
+            std::vector<Point> controlPoints;
+            std::vector<Point> fitPoints;
+            std::vector<double> knots;
+            std::vector<double> weights;
+            for (const auto& [c, v] : pairs) {
+                switch (c) {
+                    case 10: controlPoints.emplace_back(toDouble(v), 0.0); break;
+                    case 20: if (!controlPoints.empty()) controlPoints.back().y = toDouble(v); break;
+                    case 11: fitPoints.emplace_back(toDouble(v), 0.0); break;
+                    case 21: if (!fitPoints.empty()) fitPoints.back().y = toDouble(v); break;
+                    case 40: knots.push_back(toDouble(v)); break;
+                    case 41: weights.push_back(toDouble(v)); break;
+                    default: break;
+                }
+            }
+            addDXFSpline(segments, static_cast<int>(number(pairs, 71)), std::move(controlPoints), std::move(knots),
+                         std::move(weights), fitPoints, options.splineTolerance);
+        }
+    }
+    flushPolyline();
+
+    statistics.bytesRead = std::min(tokenizer.position(), data.size());
+    reportProgress();
+    spdlog::debug("Streamed {} entities ({} skipped) from {} bytes", statistics.entitiesRead, statistics.entitiesSkipped, statistics.bytesRead);
+    return statistics;
+}
+
+std::vector<DXFLayerStatistics> DXFStreamReader::scanLayers() const {
+    if (data.starts_with("AutoCAD Binary DXF")) {
+        throw std::runtime_error("Binary DXF files are not supported");
+    }
+
+    std::vector<DXFLayerStatistics> layers;
+    GroupCodeTokenizer tokenizer(data);
+    if (!skipToEntities(tokenizer)) {
+        return layers;
+    }
+
+    std::map<std::string, size_t, std::less<>> layerIndex;
+    const auto layerFor = [&](const std::string_view name) -> DXFLayerStatistics& {
+        auto it = layerIndex.find(name);
+        if (it == layerIndex.end()) {
+            it = layerIndex.emplace(std::string(name), layers.size()).first;
+            layers.push_back({.name = std::string(name)});
+        }
+        return layers[it->second];
+    };
+
+    // Layer of the POLYLINE whose vertices are being counted
+    bool inPolyline = false;
+    size_t polylineLayer = 0;
+    size_t polylineVertices = 0;
+    bool polylineClosed = false;
+    const auto flushPolyline = [&] {
+        if (inPolyline && polylineVertices >= 2) {
+            layers[polylineLayer].segments += polylineClosed ? polylineVertices : polylineVertices - 1;
+        }
+        inPolyline = false;
+    };
+
+    int code = 0;
+    std::string_view value;
+    bool more = tokenizer.next(code, value);
+    while (more) {
+        if (code != 0) {
+            more = tokenizer.next(code, value);
+            continue;
+        }
+        if (value == "ENDSEC" || value == "EOF") {
+            break;
+        }
+
+        const std::string_view type = value;
+        std::string_view layer = "0";
+        size_t points = 0;
+        size_t fitPoints = 0;
+        int flags = 0;
+        while ((more = tokenizer.next(code, value)) && code != 0) {
+            switch (code) {
+                case 8: layer = value; break;
+                case 10: points++; break;
+                case 11: fitPoints++; break;
+                case 70: flags = toInt(value); break;
+                default: break;
+            }
+        }
+
+        if (type == "VERTEX") {
+            if (!(flags & SPLINE_FRAME_VERTEX)) {
+                polylineVertices++;
+            }
+            continue;
+        }
+        if (type == "SEQEND") {
+            flushPolyline();
+            continue;
+        }
+        flushPolyline();
+
+        DXFLayerStatistics& statistics = layerFor(layer);
+        statistics.entities++;
+        if (type == "LINE" || type == "ARC") {
+            statistics.segments++;
+        } else if (type == "CIRCLE") {
+            statistics.segments += 2;
+        } else if (type == "LWPOLYLINE" && points >= 2) {
+            statistics.segments += flags & 1 ? points : points - 1;
+        } else if (type == "POLYLINE" && !(flags & (16 | 64))) {
+            inPolyline = true;
+            polylineLayer = layerIndex.find(layer)->second;
+            polylineVertices = 0;
+            polylineClosed = flags & 1;
+        } else if (type == "SPLINE") {
+            const size_t count = points > 0 ? points : fitPoints;
+            statistics.segments += count > 0 ? count - 1 : 0;
+        }
+    }
+    flushPolyline();
+
+    std::ranges::sort(layers, {}, &DXFLayerStatistics::name);
+    return layers;
+}
+
+Geometry loadDXFStreaming(const std::filesystem::path& path, const DXFImportOptions& options) {
+    spdlog::info("Streaming DXF file: {}", path.string());
+    DXFStreamReader reader(path);
+    reader.setOptions(options);
+
+    SegmentStore segments;
+    reader.read(segments);
+    return Geometry(std::move(segments));
+}
@@ -0,0 +1,91 @@
+//
+// Single-pass, memory-mapped reader for the ENTITIES section of ASCII DXF files.
+//
+
+#ifndef TURNLAB_DXFSTREAMREADER_H
+#define TURNLAB_DXFSTREAMREADER_H
+
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DXFEntities.h"
+#include "../model/geometry/Geometry.h"
+#include "../model/geometry/SegmentStore.h"
+
+struct DXFStreamStatistics {
+    size_t bytesRead = 0;
+    size_t entitiesRead = 0;
+    // Entities dropped by the filters or of an unsupported type
+    size_t entitiesSkipped = 0;
+    // INSERT entities, block references are not expanded by this reader
+    size_t blockReferences = 0;
+};
+
+struct DXFLayerStatistics {
+    std::string name;
+    size_t entities = 0;
+    size_t segments = 0;
+};
+
+// Entities between two progress reports
+#define DXF_PROGRESS_INTERVAL 1024
+
+// Receives the statistics so far and the segments read up to now, returns false to cancel
+using DXFProgressCallback = std::function<bool(const DXFStreamStatistics& progress, const SegmentStore& segments)>;
+
+// Thrown when a progress callback cancels reading. Not a std::runtime_error, so it
+// isn't mistaken for a file the streaming reader can't handle.
+class DXFImportCancelled : public std::exception {
+public:
+    const char* what() const noexcept override { return "DXF import cancelled"; }
+};
+
+// Tokenizes group code / value pairs straight from the mapped file and emits segments
+// without building an intermediate model, so memory stays bounded by the output size.
+// Supports LINE, ARC, CIRCLE, LWPOLYLINE, POLYLINE and SPLINE entities.
+class DXFStreamReader {
+public:
+    // Maps the file into memory, throws std::runtime_error if it can't be opened
+    explicit DXFStreamReader(const std::filesystem::path& path);
+    // Reads from a buffer that must outlive the reader
+    static DXFStreamReader fromBuffer(std::string_view data);
+    ~DXFStreamReader();
+
+    DXFStreamReader(const DXFStreamReader&) = delete;
+    DXFStreamReader& operator=(const DXFStreamReader&) = delete;
+
+    void setOptions(DXFImportOptions options);
+    // Called every DXF_PROGRESS_INTERVAL entities and once at the end of read()
+    void setProgressCallback(DXFProgressCallback callback);
+
+    // Appends the segments of all accepted entities to the store. Throws std::runtime_error
+    // on binary or malformed files and DXFImportCancelled if the progress callback cancels.
+    DXFStreamStatistics read(SegmentStore& segments) const;
+    // Counts the entities and segments per layer without converting anything, ignoring the options.
+    // Splines are counted by their control polygon as their tessellation isn't known yet.
+    std::vector<DXFLayerStatistics> scanLayers() const;
+
+    size_t size() const { return data.size(); }
+    std::string_view contents() const { return data; }
+
+private:
+    struct BufferTag {};
+    DXFStreamReader(BufferTag, std::string_view data) : data(data) {}
+
+    std::string_view data;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+
+    DXFImportOptions options;
+    DXFProgressCallback progressCallback;
+};
+
+// Reads the whole file with a DXFStreamReader
+Geometry loadDXFStreaming(const std::filesystem::path& path, const DXFImportOptions& options = {});
+
+#endif //TURNLAB_DXFSTREAMREADER_H
@@ -2,20 +2,92 @@
 // Created by gawain on 9/9/25.
 //
 
+#include <cmath>
+#include <string_view>
 #include <spdlog/spdlog.h>
 #include <dime/Model.h>
 #include <dime/Input.h>
 #include <dime/entities/Entity.h>
+#include <dime/entities/Arc.h>
+#include <dime/entities/Circle.h>
 #include <dime/entities/Line.h>
+#include <dime/entities/LWPolyline.h>
+#include <dime/entities/Polyline.h>
+#include <dime/entities/Spline.h>
+#include <dime/entities/Vertex.h>
 
 #include "DXFUtils.h"
 
-#include "Line.h"
-#include "Point.h"
+#include "DXFEntities.h"
 #include "Geometry.h"
-#include "Segment.h"
+#include "SegmentStore.h"
 
-Geometry loadDXF(const std::filesystem::path &path) {
+// State shared with the entity traversal callback
+struct DXFTraversal {
+    SegmentStore segments;
+    const DXFImportOptions &options;
+};
+
+static void addLWPolyline(SegmentStore& segments, const dimeLWPolyline& polyline) {
+    const int count = polyline.getNumVertices();
+    const dxfdouble* xs = polyline.getXCoords();
+    const dxfdouble* ys = polyline.getYCoords();
+    const dxfdouble* b = polyline.getBulges();
+
+    std::vector<Point> vertices;
+    std::vector<double> bulges;
+    vertices.reserve(count);
+    bulges.reserve(count);
+    for (int i = 0; i < count; i++) {
+        vertices.emplace_back(xs[i], ys[i]);
+        bulges.push_back(b ? b[i] : 0.0);
+    }
+    addDXFPolyline(segments, std::move(vertices), std::move(bulges), polyline.getFlags() & 1, polyline.getExtrusionDir().z);
+}
+
+static void addPolyline(SegmentStore& segments, const dimePolyline& polyline) {
+    // Polygon and polyface meshes are surfaces, not profiles
+    if (polyline.getFlags() & (16 | 64)) {
+        spdlog::debug("Skipping polyline mesh");
+        return;
+    }
+    const int count = polyline.getNumCoordVertices();
+    std::vector<Point> vertices;
+    std::vector<double> bulges;
+    vertices.reserve(count);
+    bulges.reserve(count);
+    for (int i = 0; i < count; i++) {
+        const dimeVertex* vertex = polyline.getCoordVertex(i);
+        vertices.emplace_back(vertex->getCoords().x, vertex->getCoords().y);
+        dimeParam bulge;
+        bulges.push_back(vertex->getRecord(42, bulge) ? bulge.double_data : 0.0);
+    }
+    addDXFPolyline(segments, std::move(vertices), std::move(bulges), polyline.getFlags() & 1, polyline.getExtrusionDir().z);
+}
+
+static void addSpline(SegmentStore& segments, const dimeSpline& entity, const double tolerance) {
+    std::vector<Point> controlPoints;
+    std::vector<double> knots;
+    std::vector<double> weights;
+    std::vector<Point> fitPoints;
+    for (int i = 0; i < entity.getNumControlPoints(); i++) {
+        controlPoints.emplace_back(entity.getControlPoint(i).x, entity.getControlPoint(i).y);
+    }
+    for (int i = 0; i < entity.getNumKnots(); i++) {
+        knots.push_back(entity.getKnotValue(i));
+    }
+    if (entity.hasWeights()) {
+        for (int i = 0; i < entity.getNumWeights(); i++) {
+            weights.push_back(entity.getWeight(i));
+        }
+    }
+    for (int i = 0; i < entity.getNumFitPoints(); i++) {
+        fitPoints.emplace_back(entity.getFitPoint(i).x, entity.getFitPoint(i).y);
+    }
+    addDXFSpline(segments, entity.getDegree(), std::move(controlPoints), std::move(knots), std::move(weights), fitPoints, tolerance);
+}
+
+Geometry loadDXF(const std::filesystem::path &path, const DXFImportOptions &options) {
     spdlog::info("Loading DXF file: {}", path.string());
     dimeModel model;
     dimeInput input;
@@ -31,23 +103,88 @@ Geometry loadDXF(const std::filesystem::path &path) {
     }
     spdlog::debug("DXF file loaded successfully");
 
-    std::vector<std::unique_ptr<Segment>> segments;
+    DXFTraversal traversal{.segments = {}, .options = options};
 
+    // Filters run first and the entity type is taken from its name, so excluded
+    // entities cost two string comparisons instead of a chain of dynamic_casts
     dimeCallback callback = [](const dimeState *state, dimeEntity *entity, void *userdata) {
-        auto *segmentList = static_cast<std::vector<std::unique_ptr<Segment>>*>(userdata);
-        spdlog::trace("Traversing entity: {}", entity->getEntityName());
-        if (const auto* line = dynamic_cast<dimeLine*>(entity)) {
-            const Point p1 = Point(line->getCoords(0).x, line->getCoords(0).y);
-            const Point p2 = Point(line->getCoords(1).x, line->getCoords(1).y);
-            Line l(p1, p2);
-            segmentList->push_back(std::make_unique<Line>(l));
+        auto *traversal = static_cast<DXFTraversal*>(userdata);
+        const DXFImportOptions &options = traversal->options;
+        const char *layer = entity->getLayerName();
+        if (!options.keepsLayer(layer ? layer : "0")) {
+            return true;
+        }
+        const std::string_view type = entity->getEntityName();
+        if (!options.keepsEntityType(type)) {
+            return true;
+        }
+
+        SegmentStore *segmentStore = &traversal->segments;
+        if (type == "LINE") {
+            const auto *line = static_cast<dimeLine*>(entity);
+            segmentStore->addLine(line->getCoords(0).x, line->getCoords(0).y, line->getCoords(1).x, line->getCoords(1).y);
+        } else if (type == "ARC") {
+            const auto *arc = static_cast<dimeArc*>(entity);
+            dimeVec3f center;
+            arc->getCenter(center);
+            addDXFArc(*segmentStore, Point(center.x, center.y), arc->getRadius(), arc->getStartAngle() * M_PI / 180.0,
+                      arc->getEndAngle() * M_PI / 180.0, arc->getExtrusionDir().z);
+        } else if (type == "CIRCLE") {
+            const auto *circle = static_cast<dimeCircle*>(entity);
+            addDXFArc(*segmentStore, Point(circle->getCenter().x, circle->getCenter().y), circle->getRadius(), 0.0, 2.0 * M_PI,
+                      circle->getExtrusionDir().z);
+        } else if (type == "LWPOLYLINE") {
+            addLWPolyline(*segmentStore, *static_cast<dimeLWPolyline*>(entity));
+        } else if (type == "POLYLINE") {
+            addPolyline(*segmentStore, *static_cast<dimePolyline*>(entity));
+        } else if (type == "SPLINE") {
+            addSpline(*segmentStore, *static_cast<dimeSpline*>(entity), options.splineTolerance);
         }
         return true;
     };
 
-    model.traverseEntities(callback, &segments);
+    model.traverseEntities(callback, &traversal);
 
     spdlog::debug("DXF file traversed successfully");
 
-    return Geometry(segments);
+    return Geometry(std::move(traversal.segments));
+}
+
+Geometry loadDXF(const std::filesystem::path &path, const GeometryCache &cache, const DXFImportOptions &options,
+                 const DXFProgressCallback &progress) {
+    // Hash the mapped file, the same mapping is then used for reading on a miss
+    std::optional<DXFStreamReader> reader;
+    try {
+        reader.emplace(path);
+    } catch (const std::runtime_error &e) {
+        spdlog::info("Failed to map DXF file ({}), reading it with dime", e.what());
+        return loadDXF(path, options);
+    }
+
+    const uint64_t key = GeometryCache::key(reader->contents(), options.hash());
+    if (std::optional<Geometry> cached = cache.load(key)) {
+        spdlog::info("Loaded {} from geometry cache", path.string());
+        return std::move(*cached);
+    }
+
+    std::optional<Geometry> geometry;
+    try {
+        reader->setOptions(options);
+        reader->setProgressCallback(progress);
+        SegmentStore segments;
+        const DXFStreamStatistics statistics = reader->read(segments);
+        if (statistics.blockReferences == 0) {
+            geometry.emplace(std::move(segments));
+        } else {
+            spdlog::info("DXF file contains {} block references, reading it with dime", statistics.blockReferences);
+        }
+    } catch (const std::runtime_error &e) {
+        spdlog::info("Streaming DXF reader failed ({}), reading it with dime", e.what());
+    }
+    if (!geometry) {
+        geometry = loadDXF(path, options);
+    }
+
+    cache.store(key, *geometry);
+    return std::move(*geometry);
 }
@@ -6,9 +6,18 @@
 #define TURNLAB_DXFUTILS_H
 #include <filesystem>
 
+#include "DXFEntities.h"
+#include "DXFStreamReader.h"
+#include "GeometryCache.h"
 #include "../model/geometry/Geometry.h"
 
-Geometry loadDXF(const std::filesystem::path &path);
+Geometry loadDXF(const std::filesystem::path &path, const DXFImportOptions &options = {});
+
+// Returns the cached geometry if this file content was imported before, otherwise reads it with
+// the streaming reader, falling back to dime for files it can't handle completely, and caches it.
+// Progress is only reported while streaming, throws DXFImportCancelled if the callback cancels.
+Geometry loadDXF(const std::filesystem::path &path, const GeometryCache &cache, const DXFImportOptions &options = {},
+                 const DXFProgressCallback &progress = {});
 
 
 #endif //TURNLAB_DXFUTILS_H
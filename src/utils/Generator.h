@@ -0,0 +1,123 @@
+//
+// Minimal pull-based coroutine generator, along the lines of C++23 std::generator.
+//
+
+#ifndef TURNLAB_GENERATOR_H
+#define TURNLAB_GENERATOR_H
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// Values are produced lazily by a coroutine using co_yield and consumed with a range-for loop.
+// The yielded value is only referenced, it stays valid until the consumer advances. A generator
+// can be iterated once, exceptions thrown in the coroutine propagate to the consumer.
+template<typename T>
+class Generator {
+public:
+    struct promise_type {
+        const T* value = nullptr;
+        std::exception_ptr exception;
+
+        Generator get_return_object() {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        // The yielded temporary outlives the suspension, so pointing at it is safe
+        std::suspend_always yield_value(const T& yielded) noexcept {
+            value = std::addressof(yielded);
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() {
+            exception = std::current_exception();
+        }
+
+        // Generators only yield, they never await
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+
+        const T& operator*() const { return *coroutine.promise().value; }
+        const T* operator->() const { return coroutine.promise().value; }
+
+        iterator& operator++() {
+            advance(coroutine);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const { return !coroutine || coroutine.done(); }
+
+    private:
+        std::coroutine_handle<promise_type> coroutine;
+    };
+
+    Generator() = default;
+
+    Generator(Generator&& other) noexcept : coroutine(std::exchange(other.coroutine, {})) {}
+
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            coroutine = std::exchange(other.coroutine, {});
+        }
+        return *this;
+    }
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    ~Generator() {
+        destroy();
+    }
+
+    // Runs the coroutine up to its first value
+    iterator begin() {
+        if (coroutine) {
+            advance(coroutine);
+        }
+        return iterator(coroutine);
+    }
+
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    explicit Generator(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+
+    static void advance(std::coroutine_handle<promise_type> coroutine) {
+        coroutine.resume();
+        if (coroutine.promise().exception) {
+            std::rethrow_exception(std::exchange(coroutine.promise().exception, {}));
+        }
+    }
+
+    void destroy() {
+        if (coroutine) {
+            coroutine.destroy();
+            coroutine = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> coroutine;
+};
+
+#endif //TURNLAB_GENERATOR_H
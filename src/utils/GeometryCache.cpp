@@ -0,0 +1,134 @@
+//
+// On-disk cache of imported geometry, keyed by source file content.
+//
+
+#include "GeometryCache.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+
+#include "CacheDirectory.h"
+#include "DXFEntities.h"
+#include "Hash.h"
+
+namespace {
+constexpr uint32_t GEOMETRY_MAGIC = 0x43474c54; // "TLGC"
+constexpr uint32_t GEOMETRY_FORMAT_VERSION = 1;
+constexpr auto CACHE_EXTENSION = ".tlgeom";
+
+template<typename T>
+void writeArray(std::ostream& out, const std::vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template<typename T>
+void readArray(std::istream& in, std::vector<T>& values, const uint64_t count) {
+    values.resize(count);
+    if (!in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)))) {
+        throw std::runtime_error("Truncated geometry data");
+    }
+}
+}
+
+void writeGeometry(std::ostream& out, const Geometry& geometry) {
+    const SegmentStore& segments = geometry.segments;
+    const uint64_t count = segments.size();
+    out.write(reinterpret_cast<const char*>(&GEOMETRY_MAGIC), sizeof(GEOMETRY_MAGIC));
+    out.write(reinterpret_cast<const char*>(&GEOMETRY_FORMAT_VERSION), sizeof(GEOMETRY_FORMAT_VERSION));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    writeArray(out, segments.kinds);
+    writeArray(out, segments.x1);
+    writeArray(out, segments.y1);
+    writeArray(out, segments.x2);
+    writeArray(out, segments.y2);
+    writeArray(out, segments.bulge);
+}
+
+Geometry readGeometry(std::istream& in) {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t count = 0;
+    in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || magic != GEOMETRY_MAGIC) {
+        throw std::runtime_error("Not a geometry file");
+    }
+    if (version != GEOMETRY_FORMAT_VERSION) {
+        throw std::runtime_error(fmt::format("Unsupported geometry format version {}", version));
+    }
+
+    // Check the count against the remaining data before allocating anything
+    const std::streampos position = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto remaining = static_cast<uint64_t>(in.tellg() - position);
+    in.seekg(position);
+    constexpr uint64_t bytesPerSegment = sizeof(SegmentKind) + 5 * sizeof(double);
+    if (remaining != count * bytesPerSegment) {
+        throw std::runtime_error("Truncated geometry data");
+    }
+
+    SegmentStore segments;
+    readArray(in, segments.kinds, count);
+    readArray(in, segments.x1, count);
+    readArray(in, segments.y1, count);
+    readArray(in, segments.x2, count);
+    readArray(in, segments.y2, count);
+    readArray(in, segments.bulge, count);
+    for (const SegmentKind kind : segments.kinds) {
+        if (kind != SegmentKind::Line && kind != SegmentKind::Arc) {
+            throw std::runtime_error("Invalid segment kind in geometry data");
+        }
+    }
+    return Geometry(std::move(segments));
+}
+
+GeometryCache::GeometryCache(std::filesystem::path directory, const uint64_t maxBytes)
+    : directory(std::move(directory)), maxBytes(maxBytes) {
+}
+
+uint64_t GeometryCache::key(const std::string_view content, const uint64_t options) {
+    uint64_t result = contentHash(content);
+    result = hashCombine(result, DXF_IMPORTER_VERSION);
+    result = hashCombine(result, GEOMETRY_FORMAT_VERSION);
+    return hashCombine(result, options);
+}
+
+std::filesystem::path GeometryCache::pathFor(const uint64_t key) const {
+    return directory / fmt::format("{:016x}{}", key, CACHE_EXTENSION);
+}
+
+std::optional<Geometry> GeometryCache::load(const uint64_t key) const {
+    const std::filesystem::path path = pathFor(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    try {
+        Geometry geometry = readGeometry(file);
+        file.close();
+        touchCacheEntry(path);
+        spdlog::debug("Loaded {} segments from geometry cache {}", geometry.segments.size(), path.string());
+        return geometry;
+    } catch (const std::runtime_error& e) {
+        spdlog::warn("Discarding invalid geometry cache entry {}: {}", path.string(), e.what());
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        return std::nullopt;
+    }
+}
+
+void GeometryCache::store(const uint64_t key, const Geometry& geometry) const {
+    if (writeCacheEntry(pathFor(key), [&](std::ostream& out) { writeGeometry(out, geometry); })) {
+        evict();
+    }
+}
+
+void GeometryCache::evict() const {
+    evictCacheEntries(directory, CACHE_EXTENSION, maxBytes);
+}
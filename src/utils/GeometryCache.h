@@ -0,0 +1,48 @@
+//
+// On-disk cache of imported geometry, keyed by source file content.
+//
+
+#ifndef TURNLAB_GEOMETRYCACHE_H
+#define TURNLAB_GEOMETRYCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+
+#include "../model/geometry/Geometry.h"
+
+// Upper bound for the total size of the cache directory, in bytes
+#define DEFAULT_GEOMETRY_CACHE_SIZE (256ull * 1024 * 1024)
+
+// Stores each geometry as a compact binary dump of its segment arrays in one file per key.
+// Entries are evicted least recently used first once the directory outgrows maxBytes,
+// the file modification time serving as the last access time.
+class GeometryCache {
+public:
+    explicit GeometryCache(std::filesystem::path directory, uint64_t maxBytes = DEFAULT_GEOMETRY_CACHE_SIZE);
+
+    // Key for a source file, options covers anything else affecting the import such as tolerances
+    static uint64_t key(std::string_view content, uint64_t options = 0);
+
+    // Returns nullopt on a miss, unreadable entries are removed and count as a miss
+    std::optional<Geometry> load(uint64_t key) const;
+    // Failures are logged, the cache is only an optimization
+    void store(uint64_t key, const Geometry& geometry) const;
+    void evict() const;
+
+    const std::filesystem::path& getDirectory() const { return directory; }
+
+private:
+    std::filesystem::path pathFor(uint64_t key) const;
+
+    std::filesystem::path directory;
+    uint64_t maxBytes;
+};
+
+// Binary geometry format, host byte order. readGeometry throws std::runtime_error on invalid data.
+void writeGeometry(std::ostream& out, const Geometry& geometry);
+Geometry readGeometry(std::istream& in);
+
+#endif //TURNLAB_GEOMETRYCACHE_H
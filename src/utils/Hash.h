@@ -0,0 +1,64 @@
+//
+// Non-cryptographic 64-bit hashes used for cache keys.
+//
+
+#ifndef TURNLAB_HASH_H
+#define TURNLAB_HASH_H
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+// FNV-1a, byte at a time, for short keys
+constexpr uint64_t fnv1a(const std::string_view data, uint64_t hash = FNV_OFFSET_BASIS) {
+    for (const char c : data) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+constexpr uint64_t hashCombine(const uint64_t seed, const uint64_t value) {
+    return (seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2))) * FNV_PRIME;
+}
+
+// Hash of large buffers such as whole files. Mixes four independent 64-bit lanes
+// per 32 bytes so it runs at memory speed, the tail is folded in with FNV-1a.
+inline uint64_t contentHash(const std::string_view data) {
+    constexpr uint64_t P1 = 0x9e3779b185ebca87ull;
+    constexpr uint64_t P2 = 0xc2b2ae3d27d4eb4full;
+    const auto round = [](const uint64_t lane, const uint64_t word) {
+        return std::rotl(lane + word * P2, 31) * P1;
+    };
+
+    uint64_t lanes[4] = {P1 + P2, P2, 0, 0 - P1};
+    const char* p = data.data();
+    const char* const blocksEnd = p + (data.size() & ~size_t{31});
+    for (; p < blocksEnd; p += 32) {
+        for (int i = 0; i < 4; i++) {
+            uint64_t word;
+            std::memcpy(&word, p + 8 * i, sizeof(word));
+            lanes[i] = round(lanes[i], word);
+        }
+    }
+
+    uint64_t hash = data.size();
+    for (const uint64_t lane : lanes) {
+        hash = (hash ^ round(0, lane)) * P1;
+    }
+    hash = fnv1a(std::string_view(p, data.data() + data.size() - p), hash);
+
+    // Final avalanche so every input bit affects every output bit
+    hash ^= hash >> 33;
+    hash *= P2;
+    hash ^= hash >> 29;
+    hash *= P1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+#endif //TURNLAB_HASH_H
@@ -9,6 +9,7 @@
 #include <pybind11/embed.h>
 #include <spdlog/spdlog.h>
 #include <filesystem>
+#include <sstream>
 
 namespace py = pybind11;
 
@@ -63,39 +64,72 @@ void PythonPostProcessor::loadModules() {
     }
 }
 
-std::string PythonPostProcessor::processToolpath(const std::unique_ptr<TToolpath>& toolpath, PostProcessorState& state) {
+std::string PythonPostProcessor::processToolpath(const TMove& move, const TMoveState& moveState, PostProcessorState& state) {
     std::string gcode;
 
-    gcode += setupTool(toolpath, state);
+    gcode += setupTool(moveState.toolNumber, state);
 
     // Handle spindle speed changes
-    if (state.currentRpm != toolpath->rpm) {
-        gcode += callPostProcessor("spindle_on", toolpath->rpm);
-        state.currentRpm = toolpath->rpm;
+    if (state.currentRpm != moveState.rpm) {
+        gcode += callPostProcessor("spindle_on", moveState.rpm);
+        state.currentRpm = moveState.rpm;
         state.spindleOn = true;
     }
 
+    // Rapids traverse at machine speed, dwells hold position, everything else is interpolated
+    if (move.kind == TMoveKind::Rapid && move.type == TToolpathType::Line) {
+        gcode += callPostProcessor("rapid_move", move.end, moveState.feedRate);
+        return gcode;
+    }
+    if (move.kind == TMoveKind::Dwell) {
+        gcode += callPostProcessor("dwell", move.duration);
+        return gcode;
+    }
+
     // Process specific toolpath type
-    if (auto line = dynamic_cast<TLine*>(toolpath.get())) {
-        gcode += callPostProcessor("linear_move", line->end, line->feedRate);
-    } else {
-        spdlog::warn("Unsupported toolpath type");
+    switch (move.type) {
+        case TToolpathType::Line:
+            gcode += callPostProcessor("linear_move", move.end, moveState.feedRate);
+            break;
+        case TToolpathType::Arc:
+            gcode += callPostProcessor("arc_move", move.end, move.center, move.clockwise, moveState.feedRate);
+            break;
+        default:
+            spdlog::warn("Unsupported toolpath type");
+            break;
     }
 
     return gcode;
 }
 
-std::string PythonPostProcessor::setupTool(const std::unique_ptr<TToolpath>& toolpath, PostProcessorState& state) {
+std::string PythonPostProcessor::setupTool(const int toolNumber, PostProcessorState& state) {
     std::string gcode = "";
-    if (state.currentTool != toolpath->toolNumber) {
-        gcode += callPostProcessor("tool_change", toolpath->toolNumber);
-        state.currentTool = toolpath->toolNumber;
+    if (state.currentTool != toolNumber) {
+        gcode += callPostProcessor("tool_change", toolNumber);
+        state.currentTool = toolNumber;
     }
     return gcode;
 }
 
 std::string PythonPostProcessor::generateGCode(const std::vector<TToolpathSequence>& toolpaths) {
-    spdlog::info("PythonPostProcessor::generateGCode() called with {} toolpath sequences", toolpaths.size());
+    std::vector<TMoveStream> streams;
+    streams.reserve(toolpaths.size());
+    for (const auto& sequence : toolpaths) {
+        streams.push_back(streamMoves(sequence));
+    }
+    return generateGCode(std::move(streams));
+}
+
+std::string PythonPostProcessor::generateGCode(std::vector<TMoveStream> streams) {
+    std::ostringstream gcode;
+    if (!generateGCode(std::move(streams), gcode)) {
+        return "";
+    }
+    return gcode.str();
+}
+
+bool PythonPostProcessor::generateGCode(std::vector<TMoveStream> streams, std::ostream& out) {
+    spdlog::info("PythonPostProcessor::generateGCode() called with {} toolpath streams", streams.size());
 
     spdlog::info("Creating Python interpreter");
     py::scoped_interpreter guard{};
@@ -103,29 +137,37 @@ std::string PythonPostProcessor::generateGCode(const std::vector<TToolpathSequen
     try {
         loadModules();
 
-        std::string gcode;
+        size_t written = 0;
+        const auto write = [&](const std::string& gcode) {
+            out << gcode;
+            written += gcode.size();
+        };
         PostProcessorState state;
 
-        // Process each toolpath sequence
-        for (const auto& sequence : toolpaths) {
-            gcode += setupTool(sequence.toolpaths[0], state);
-            gcode += callPostProcessor("rapid_move", sequence.toolpaths[0]->getStartPosition(), 100.0);
-            for (const auto& toolpath : sequence.toolpaths) {
-                gcode += processToolpath(toolpath, state);
+        // Process each toolpath stream, moves are posted as they are produced
+        for (auto& stream : streams) {
+            bool first = true;
+            for (const auto& [move, moveState] : stream) {
+                if (first) {
+                    write(setupTool(moveState.toolNumber, state));
+                    write(callPostProcessor("rapid_move", move.start, 100.0));
+                    first = false;
+                }
+                write(processToolpath(move, moveState, state));
             }
         }
 
         // Turn off spindle at end if it was on
         if (state.spindleOn) {
-            gcode += callPostProcessor("spindle_off");
+            write(callPostProcessor("spindle_off"));
         }
 
-        spdlog::info("Generated {} characters of GCode", gcode.length());
+        spdlog::info("Generated {} characters of GCode", written);
 
         // Release Python objects before interpreter destruction
         pImpl->pyPostProcessor = py::none();
 
-        return gcode;
+        return static_cast<bool>(out);
 
     } catch (const std::exception& e) {
         spdlog::error("Error generating GCode: {}", e.what());
@@ -133,7 +175,7 @@ std::string PythonPostProcessor::generateGCode(const std::vector<TToolpathSequen
         // Release Python objects before interpreter destruction
         pImpl->pyPostProcessor = py::none();
 
-        return "";
+        return false;
     }
 }
 
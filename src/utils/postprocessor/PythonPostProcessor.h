@@ -5,6 +5,7 @@
 #ifndef TURNLAB_PYTHONPOSTPRECESSOR_H
 #define TURNLAB_PYTHONPOSTPRECESSOR_H
 
+#include <iosfwd>
 #include <string>
 #include <vector>
 #include <memory>
@@ -29,8 +30,8 @@ class PythonPostProcessor {
     std::unique_ptr<Impl> pImpl;  // Pointer to implementation
 
     void loadModules();
-    std::string processToolpath(const std::unique_ptr<TToolpath>& toolpath, PostProcessorState& state);
-    std::string setupTool(const std::unique_ptr<TToolpath> &toolpath, PostProcessorState &state);
+    std::string processToolpath(const TMove& move, const TMoveState& moveState, PostProcessorState& state);
+    std::string setupTool(int toolNumber, PostProcessorState &state);
 
     template<typename... Args>
     std::string callPostProcessor(const std::string& method, Args&&... args);
@@ -40,6 +41,11 @@ public:
     ~PythonPostProcessor();  // Required for unique_ptr with forward-declared type
 
     std::string generateGCode(const std::vector<TToolpathSequence>& toolpaths);
+    // Empty streams are skipped, each stream is consumed once
+    std::string generateGCode(std::vector<TMoveStream> streams);
+    // Writes the G-code to out as the moves are produced, so memory does not grow with the
+    // toolpaths. Returns false if posting failed, out may then hold partial output.
+    bool generateGCode(std::vector<TMoveStream> streams, std::ostream& out);
 };
 
 
@@ -12,6 +12,7 @@
 #include "../../model/toolpath/TPoint.h"
 #include "../../model/toolpath/TToolpath.h"
 #include "../../model/toolpath/TLine.h"
+#include "../../model/toolpath/TArc.h"
 #include "../../model/toolpath/TToolpathSequence.h"
 
 namespace py = pybind11;
@@ -24,9 +25,11 @@ public:
 
     virtual std::string rapidMove(TPoint point, double feedrate) { return ""; }
     virtual std::string linearMove(TPoint point, double feedrate) { return ""; }
+    virtual std::string arcMove(TPoint point, TPoint center, bool clockwise, double feedrate) { return ""; }
     virtual std::string spindleOn(double rpm) { return ""; }
     virtual std::string spindleOff() { return ""; }
     virtual std::string toolChange(int toolNumber) { return ""; }
+    virtual std::string dwell(double seconds) { return ""; }
 
 protected:
     MachineConfig config;
@@ -59,6 +62,16 @@ void init_py_module(py::module& m) {
     // Bind TToolpathType enum
     py::enum_<TToolpathType>(m, "ToolpathType")
         .value("Line", TToolpathType::Line)
+        .value("Arc", TToolpathType::Arc)
+        .export_values();
+
+    spdlog::info("Registering TMoveKind enum");
+    py::enum_<TMoveKind>(m, "MoveKind")
+        .value("Rapid", TMoveKind::Rapid)
+        .value("Feed", TMoveKind::Feed)
+        .value("Retract", TMoveKind::Retract)
+        .value("Plunge", TMoveKind::Plunge)
+        .value("Dwell", TMoveKind::Dwell)
         .export_values();
 
     spdlog::info("Registering TPoint class");
@@ -75,30 +88,52 @@ void init_py_module(py::module& m) {
         .def_readwrite("tool_number", &TToolpath::toolNumber)
         .def_readwrite("feed_rate", &TToolpath::feedRate)
         .def_readwrite("rpm", &TToolpath::rpm)
-        .def_readonly("type", &TToolpath::type);
+        .def_readonly("type", &TToolpath::type)
+        .def_readwrite("kind", &TToolpath::kind);
 
     spdlog::info("Registering TLine class as 'ToolpathLine'");
     // Bind TLine
     py::class_<TLine, TToolpath>(m, "ToolpathLine")
         .def(py::init<>())
-        .def(py::init<const TPoint&, const TPoint&, int, double, double>(),
+        .def(py::init<const TPoint&, const TPoint&, int, double, double, TMoveKind>(),
              py::arg("start"), py::arg("end"),
-             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0)
-        .def(py::init<double, double, double, double, int, double, double>(),
+             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0, py::arg("kind") = TMoveKind::Feed)
+        .def(py::init<double, double, double, double, int, double, double, TMoveKind>(),
              py::arg("start_x"), py::arg("start_z"), py::arg("end_x"), py::arg("end_z"),
-             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0)
+             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0, py::arg("kind") = TMoveKind::Feed)
         .def_readwrite("start", &TLine::start)
         .def_readwrite("end", &TLine::end);
 
+    spdlog::info("Registering TArc class as 'ToolpathArc'");
+    // Bind TArc
+    py::class_<TArc, TToolpath>(m, "ToolpathArc")
+        .def(py::init<>())
+        .def(py::init<const TPoint&, const TPoint&, const TPoint&, bool, int, double, double, TMoveKind>(),
+             py::arg("start"), py::arg("end"), py::arg("center"), py::arg("clockwise"),
+             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0, py::arg("kind") = TMoveKind::Feed)
+        .def_readwrite("start", &TArc::start)
+        .def_readwrite("end", &TArc::end)
+        .def_readwrite("center", &TArc::center)
+        .def_readwrite("clockwise", &TArc::clockwise);
+
     // Bind TToolpathSequence
     py::class_<TToolpathSequence>(m, "ToolpathSequence")
         .def(py::init<>())
-        .def("add_line", py::overload_cast<const TPoint&, const TPoint&, int, double, double>(&TToolpathSequence::addLine),
+        .def("add_line", py::overload_cast<const TPoint&, const TPoint&, int, double, double, TMoveKind>(&TToolpathSequence::addLine),
              py::arg("start"), py::arg("end"),
-             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0)
-        .def("add_line", py::overload_cast<double, double, double, double, int, double, double>(&TToolpathSequence::addLine),
+             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0, py::arg("kind") = TMoveKind::Feed)
+        .def("add_line", py::overload_cast<double, double, double, double, int, double, double, TMoveKind>(&TToolpathSequence::addLine),
              py::arg("start_x"), py::arg("start_z"), py::arg("end_x"), py::arg("end_z"),
+             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0, py::arg("kind") = TMoveKind::Feed)
+        .def("add_arc", py::overload_cast<const TPoint&, const TPoint&, const TPoint&, bool, int, double, double, TMoveKind>(&TToolpathSequence::addArc),
+             py::arg("start"), py::arg("end"), py::arg("center"), py::arg("clockwise"),
+             py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0, py::arg("kind") = TMoveKind::Feed)
+        .def("add_rapid", &TToolpathSequence::addRapid,
+             py::arg("start"), py::arg("end"),
              py::arg("tool_number") = 0, py::arg("feed_rate") = 100.0, py::arg("rpm") = 1000.0)
+        .def("add_dwell", &TToolpathSequence::addDwell,
+             py::arg("position"), py::arg("seconds"),
+             py::arg("tool_number") = 0, py::arg("rpm") = 1000.0)
         .def("size", &TToolpathSequence::size)
         .def("empty", &TToolpathSequence::empty)
         .def("clear", &TToolpathSequence::clear)
@@ -110,7 +145,9 @@ void init_py_module(py::module& m) {
         .def(py::init<MachineConfig, ToolTable>())
         .def("rapid_move", &PostProcessor::rapidMove)
         .def("linear_move", &PostProcessor::linearMove)
+        .def("arc_move", &PostProcessor::arcMove)
         .def("spindle_on", &PostProcessor::spindleOn)
         .def("spindle_off", &PostProcessor::spindleOff)
-        .def("tool_change", &PostProcessor::toolChange);
+        .def("tool_change", &PostProcessor::toolChange)
+        .def("dwell", &PostProcessor::dwell);
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+//
+// Profile chains in toolpath coordinates, built from selected geometry and offset for allowance.
+//
+
+#include "Contour.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <spdlog/fmt/fmt.h>
+
+namespace {
+// Lengths below this are treated as zero, in mm
+constexpr double EPSILON = 1e-9;
+
+// Vector in the Z/X plane, u along Z and v along X, the orientation arcs are measured in
+struct Vec2 {
+    double u;
+    double v;
+};
+
+Vec2 operator-(const TPoint& a, const TPoint& b) {
+    return {a.z - b.z, a.x - b.x};
+}
+
+TPoint offsetPoint(const TPoint& point, const Vec2& direction, const double distance) {
+    return {point.x + direction.v * distance, point.z + direction.u * distance};
+}
+
+double dot(const Vec2& a, const Vec2& b) {
+    return a.u * b.u + a.v * b.v;
+}
+
+double cross(const Vec2& a, const Vec2& b) {
+    return a.u * b.v - a.v * b.u;
+}
+
+double length(const Vec2& a) {
+    return std::hypot(a.u, a.v);
+}
+
+Vec2 unit(const Vec2& a) {
+    const double l = length(a);
+    return l > EPSILON ? Vec2{a.u / l, a.v / l} : Vec2{0.0, 0.0};
+}
+
+Vec2 leftNormal(const Vec2& direction) {
+    return {-direction.v, direction.u};
+}
+
+double distance(const TPoint& a, const TPoint& b) {
+    return length(a - b);
+}
+
+Vec2 tangentAt(const ContourElement& element, const TPoint& point) {
+    if (!element.arc) {
+        return unit(element.end - element.start);
+    }
+    const Vec2 radial = unit(point - element.center);
+    return element.clockwise ? Vec2{radial.v, -radial.u} : Vec2{-radial.v, radial.u};
+}
+
+// Intersection of the line or circle carrying a with the one carrying b, closest to near
+std::optional<TPoint> intersection(const ContourElement& a, const ContourElement& b, const TPoint& near) {
+    std::vector<TPoint> candidates;
+    const auto lineCircle = [&](const ContourElement& line, const ContourElement& circle) {
+        const Vec2 direction = unit(line.end - line.start);
+        const Vec2 fromCenter = line.start - circle.center;
+        const double radius = distance(circle.start, circle.center);
+        const double half = dot(fromCenter, direction);
+        const double discriminant = half * half - (dot(fromCenter, fromCenter) - radius * radius);
+        if (discriminant < 0.0) {
+            return;
+        }
+        const double root = std::sqrt(discriminant);
+        candidates.push_back(offsetPoint(line.start, direction, -half - root));
+        candidates.push_back(offsetPoint(line.start, direction, -half + root));
+    };
+
+    if (!a.arc && !b.arc) {
+        const Vec2 r = a.end - a.start;
+        const Vec2 s = b.end - b.start;
+        const double denominator = cross(r, s);
+        if (std::abs(denominator) > EPSILON) {
+            candidates.push_back(offsetPoint(a.start, r, cross(b.start - a.start, s) / denominator));
+        }
+    } else if (!a.arc) {
+        lineCircle(a, b);
+    } else if (!b.arc) {
+        lineCircle(b, a);
+    } else {
+        const Vec2 between = b.center - a.center;
+        const double d = length(between);
+        const double ra = distance(a.start, a.center);
+        const double rb = distance(b.start, b.center);
+        if (d > EPSILON && d <= ra + rb && d >= std::abs(ra - rb)) {
+            const double along = (ra * ra - rb * rb + d * d) / (2.0 * d);
+            const double across = std::sqrt(std::max(0.0, ra * ra - along * along));
+            const Vec2 axis = unit(between);
+            const TPoint base = offsetPoint(a.center, axis, along);
+            candidates.push_back(offsetPoint(base, leftNormal(axis), across));
+            candidates.push_back(offsetPoint(base, leftNormal(axis), -across));
+        }
+    }
+
+    if (candidates.empty()) {
+        return std::nullopt;
+    }
+    return *std::min_element(candidates.begin(), candidates.end(), [&](const TPoint& p, const TPoint& q) {
+        return distance(p, near) < distance(q, near);
+    });
+}
+}
+
+TPoint startDirection(const ContourElement& element) {
+    const Vec2 direction = tangentAt(element, element.start);
+    return {direction.v, direction.u};
+}
+
+TPoint endDirection(const ContourElement& element) {
+    const Vec2 direction = tangentAt(element, element.end);
+    return {direction.v, direction.u};
+}
+
+Contour buildContour(const SegmentStore& segments, const std::vector<size_t>& selection, const double tolerance) {
+    if (selection.empty()) {
+        throw std::invalid_argument("No geometry selected");
+    }
+
+    // Geometry x is axial and y radial
+    const auto startOf = [&](const size_t index) { return TPoint(segments.y1[index], segments.x1[index]); };
+    const auto endOf = [&](const size_t index) { return TPoint(segments.y2[index], segments.x2[index]); };
+    const auto checkIndex = [&](const size_t index) {
+        if (index >= segments.size()) {
+            throw std::invalid_argument(fmt::format("Segment {} does not exist", index));
+        }
+    };
+
+    Contour contour;
+    contour.reserve(selection.size());
+    for (size_t i = 0; i < selection.size(); i++) {
+        const size_t index = selection[i];
+        checkIndex(index);
+        const TPoint start = startOf(index);
+        const TPoint end = endOf(index);
+
+        bool reversed;
+        if (i == 0) {
+            // The first segment is turned towards the second one
+            reversed = false;
+            if (selection.size() > 1) {
+                checkIndex(selection[1]);
+                const TPoint nextStart = startOf(selection[1]);
+                const TPoint nextEnd = endOf(selection[1]);
+                reversed = std::min(distance(start, nextStart), distance(start, nextEnd)) <
+                           std::min(distance(end, nextStart), distance(end, nextEnd));
+            }
+        } else {
+            const TPoint& previous = contour.back().end;
+            if (distance(start, previous) <= tolerance) {
+                reversed = false;
+            } else if (distance(end, previous) <= tolerance) {
+                reversed = true;
+            } else {
+                throw std::invalid_argument(fmt::format("Segment {} does not connect to segment {}", index, selection[i - 1]));
+            }
+        }
+
+        ContourElement element{reversed ? end : start, reversed ? start : end, {}};
+        if (segments.kinds[index] == SegmentKind::Arc && segments.bulge[index] != 0.0) {
+            const Point center = segments[index].asArc()->center();
+            element.center = TPoint(center.y, center.x);
+            element.arc = true;
+            element.clockwise = (segments.bulge[index] < 0.0) != reversed;
+        }
+        // Snapped so the contour is exactly continuous
+        if (!contour.empty()) {
+            element.start = contour.back().end;
+        }
+        contour.push_back(element);
+    }
+    return contour;
+}
+
+void orientTowardsChuck(Contour& contour, const AxisDirection zAxisDirection) {
+    if (contour.empty()) {
+        return;
+    }
+    // Moving towards the tailstock is positive for a positive Z axis
+    const double towardsTailstock = zAxisDirection == AxisDirection::Positive ? 1.0 : -1.0;
+    if (contour.front().start.z * towardsTailstock >= contour.back().end.z * towardsTailstock) {
+        return;
+    }
+
+    std::reverse(contour.begin(), contour.end());
+    for (auto& element : contour) {
+        std::swap(element.start, element.end);
+        element.clockwise = !element.clockwise;
+    }
+}
+
+double outwardSide(const Contour& contour) {
+    double away = 0.0;
+    for (const auto& element : contour) {
+        for (const TPoint& point : {element.start, element.end}) {
+            const Vec2 outward{0.0, point.x >= 0.0 ? 1.0 : -1.0};
+            away += dot(leftNormal(tangentAt(element, point)), outward);
+        }
+    }
+    return away >= 0.0 ? 1.0 : -1.0;
+}
+
+Contour offsetContour(const Contour& contour, const double distance) {
+    if (contour.empty() || distance == 0.0) {
+        return contour;
+    }
+
+    const double side = outwardSide(contour);
+
+    Contour result;
+    result.reserve(contour.size() * 2);
+    const ContourElement* previous = nullptr;
+    for (const auto& element : contour) {
+        ContourElement offset = element;
+        offset.start = offsetPoint(element.start, leftNormal(tangentAt(element, element.start)), side * distance);
+        offset.end = offsetPoint(element.end, leftNormal(tangentAt(element, element.end)), side * distance);
+        if (element.arc) {
+            // Offsetting towards the center shrinks the arc, it disappears once the radius is gone
+            const double radius = ::distance(element.start, element.center);
+            const Vec2 radial = unit(element.start - element.center);
+            if (radius + side * distance * dot(leftNormal(tangentAt(element, element.start)), radial) <= EPSILON) {
+                continue;
+            }
+        }
+
+        if (result.empty()) {
+            result.push_back(offset);
+            previous = &element;
+            continue;
+        }
+
+        ContourElement& last = result.back();
+        const TPoint& vertex = element.start;
+        if (::distance(last.end, offset.start) > EPSILON) {
+            const Vec2 exit = tangentAt(*previous, previous->end);
+            const Vec2 entry = tangentAt(element, element.start);
+            const double turn = cross(exit, entry);
+            if (std::abs(turn) <= EPSILON && dot(exit, entry) > 0.0) {
+                // Tangent within rounding, bridge the remaining gap
+                result.push_back({last.end, offset.start, {}});
+            } else if (turn * side < 0.0 || std::abs(turn) <= EPSILON) {
+                // Convex corner, the offsets leave a gap that is closed around the vertex
+                result.push_back({last.end, offset.start, vertex, true, side > 0.0});
+            } else if (const std::optional<TPoint> trimmed = intersection(last, offset, vertex)) {
+                // Concave corner, the offsets overlap
+                last.end = *trimmed;
+                offset.start = *trimmed;
+            } else {
+                result.push_back({last.end, offset.start, {}});
+            }
+        }
+        offset.start = result.back().end;
+        result.push_back(offset);
+        previous = &element;
+    }
+    return result;
+}
+
+std::vector<TPoint> flattenContour(const Contour& contour, const double tolerance) {
+    std::vector<TPoint> points;
+    if (contour.empty()) {
+        return points;
+    }
+    points.reserve(contour.size() + 1);
+    points.push_back(contour.front().start);
+    for (const auto& element : contour) {
+        if (element.arc) {
+            const double radius = ::distance(element.start, element.center);
+            const double startAngle = std::atan2(element.start.x - element.center.x, element.start.z - element.center.z);
+            const double endAngle = std::atan2(element.end.x - element.center.x, element.end.z - element.center.z);
+            double sweep = endAngle - startAngle;
+            if (element.clockwise && sweep >= 0.0) {
+                sweep -= 2.0 * M_PI;
+            } else if (!element.clockwise && sweep <= 0.0) {
+                sweep += 2.0 * M_PI;
+            }
+            // Largest angle whose chord stays within tolerance of the arc
+            const double maxStep = radius > tolerance ? 2.0 * std::acos(1.0 - tolerance / radius) : M_PI;
+            const int steps = std::max(1, static_cast<int>(std::ceil(std::abs(sweep) / maxStep)));
+            for (int i = 1; i < steps; i++) {
+                const double angle = startAngle + sweep * i / steps;
+                points.emplace_back(element.center.x + radius * std::sin(angle), element.center.z + radius * std::cos(angle));
+            }
+        }
+        points.push_back(element.end);
+    }
+    return points;
+}
@@ -0,0 +1,56 @@
+//
+// Profile chains in toolpath coordinates, built from selected geometry and offset for allowance.
+//
+
+#ifndef TURNLAB_CONTOUR_H
+#define TURNLAB_CONTOUR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../../model/MachineConfig.h"
+#include "../../model/geometry/SegmentStore.h"
+#include "../../model/toolpath/TPoint.h"
+
+// Endpoints of consecutive selected segments closer than this are considered connected, in mm
+#define DEFAULT_CONTOUR_TOLERANCE 1e-3
+
+// A line or arc of a contour, x radial and z axial like the toolpaths
+struct ContourElement {
+    TPoint start;
+    TPoint end;
+    // Arcs only
+    TPoint center;
+    bool arc = false;
+    bool clockwise = false;
+};
+
+using Contour = std::vector<ContourElement>;
+
+// Unit direction of travel where the element starts and where it ends
+TPoint startDirection(const ContourElement& element);
+TPoint endDirection(const ContourElement& element);
+
+// Chains the selected segments in selection order, each segment turned to continue where the
+// previous one ended. Throws std::invalid_argument for an empty selection, an index out of range
+// or consecutive segments that do not meet within tolerance.
+Contour buildContour(const SegmentStore& segments, const std::vector<size_t>& selection, double tolerance = DEFAULT_CONTOUR_TOLERANCE);
+
+// Reverses the contour if needed so it runs from its tailstock end towards the chuck
+void orientTowardsChuck(Contour& contour, AxisDirection zAxisDirection);
+
+// Side of the direction of travel facing away from the centerline, 1 for left and -1 for right.
+// Decided over the whole contour, so elements running radially take the side of their neighbours.
+double outwardSide(const Contour& contour);
+
+// Offsets the contour by distance to the side facing away from the centerline. Convex corners are
+// rounded with arcs around the original vertex, at concave corners the neighbouring elements are
+// trimmed to their intersection. Works corner by corner in linear time, so an offset larger than
+// the features of the profile is not cleaned up globally. Arcs whose radius would vanish are
+// dropped.
+Contour offsetContour(const Contour& contour, double distance);
+
+// Points of the contour as a polyline, arcs split into chords that stay within tolerance of them
+std::vector<TPoint> flattenContour(const Contour& contour, double tolerance = DEFAULT_CONTOUR_TOLERANCE);
+
+#endif //TURNLAB_CONTOUR_H
@@ -0,0 +1,197 @@
+//
+// Cycle time estimation for generated toolpaths.
+//
+
+#include "CycleTimeEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/fmt/fmt.h>
+
+namespace {
+struct Direction {
+    double z;
+    double x;
+};
+
+Direction normalized(const double z, const double x) {
+    const double length = std::hypot(z, x);
+    return length > 0.0 ? Direction{z / length, x / length} : Direction{0.0, 0.0};
+}
+
+// Direction of travel on an arc at one of its points, in the Z/X plane
+Direction arcTangent(const TMove& arc, const TPoint& point) {
+    const Direction radial = normalized(point.z - arc.center.z, point.x - arc.center.x);
+    return arc.clockwise ? Direction{radial.x, -radial.z} : Direction{-radial.x, radial.z};
+}
+
+double arcLength(const TMove& arc) {
+    const double radius = std::hypot(arc.start.z - arc.center.z, arc.start.x - arc.center.x);
+    const double startAngle = std::atan2(arc.start.x - arc.center.x, arc.start.z - arc.center.z);
+    const double endAngle = std::atan2(arc.end.x - arc.center.x, arc.end.z - arc.center.z);
+    double sweep = endAngle - startAngle;
+    if (arc.clockwise && sweep >= 0.0) {
+        sweep -= 2.0 * M_PI;
+    } else if (!arc.clockwise && sweep <= 0.0) {
+        sweep += 2.0 * M_PI;
+    }
+    return radius * std::abs(sweep);
+}
+}
+
+CycleTimeEstimate& CycleTimeEstimate::operator+=(const CycleTimeEstimate& other) {
+    cuttingTime += other.cuttingTime;
+    positioningTime += other.positioningTime;
+    dwellTime += other.dwellTime;
+    toolChangeTime += other.toolChangeTime;
+    spindleTime += other.spindleTime;
+    toolChanges += other.toolChanges;
+    return *this;
+}
+
+CycleTimeEstimator::CycleTimeEstimator(const MachineConfig& machineConfig)
+    : rapidFeedRate(machineConfig.rapidFeedRate),
+      maxFeedRate(machineConfig.maxFeedRateMMMin),
+      acceleration(machineConfig.axisAcceleration),
+      spindleAcceleration(machineConfig.spindleAcceleration),
+      toolChangeTime(machineConfig.toolChangeTime) {
+}
+
+CycleTimeEstimate CycleTimeEstimator::estimate(const TToolpathSequence& sequence) {
+    SpindleState spindle;
+    return estimate(sequence, spindle);
+}
+
+ProjectCycleTime CycleTimeEstimator::estimateProject(const std::vector<TToolpathSequence>& sequences) {
+    ProjectCycleTime result;
+    result.operations.reserve(sequences.size());
+    SpindleState spindle;
+    for (const auto& sequence : sequences) {
+        result.operations.push_back(estimate(sequence, spindle));
+        result.total += result.operations.back();
+    }
+    return result;
+}
+
+CycleTimeEstimate CycleTimeEstimator::estimate(const TToolpathSequence& sequence, SpindleState& spindle) {
+    CycleTimeEstimate result;
+
+    for (const auto& run : sequence.states()) {
+        if (run.state.toolNumber != spindle.toolNumber) {
+            spindle.toolNumber = run.state.toolNumber;
+            result.toolChanges++;
+            result.toolChangeTime += toolChangeTime;
+        }
+        if (run.state.rpm != spindle.rpm) {
+            if (spindleAcceleration > 0.0) {
+                result.spindleTime += std::abs(run.state.rpm - spindle.rpm) / spindleAcceleration;
+            }
+            spindle.rpm = run.state.rpm;
+        }
+    }
+
+    // First pass: move lengths, cruise speeds and the speed each junction allows
+    profiles.clear();
+    profiles.reserve(sequence.size());
+    Direction previousExit{0.0, 0.0};
+    double previousCruise = 0.0;
+    for (const auto [move, state] : sequence) {
+        if (move.kind == TMoveKind::Dwell) {
+            result.dwellTime += move.duration;
+            // The machine stands still, so the next move starts from rest
+            profiles.push_back({0.0, 0.0, 0.0, false});
+            previousCruise = 0.0;
+            continue;
+        }
+
+        double length;
+        Direction entry;
+        Direction exit;
+        if (move.type == TToolpathType::Arc) {
+            length = arcLength(move);
+            entry = arcTangent(move, move.start);
+            exit = arcTangent(move, move.end);
+        } else {
+            length = std::hypot(move.end.z - move.start.z, move.end.x - move.start.x);
+            entry = exit = normalized(move.end.z - move.start.z, move.end.x - move.start.x);
+        }
+
+        double feedRate = move.kind == TMoveKind::Rapid ? rapidFeedRate : state.feedRate;
+        if (move.kind != TMoveKind::Rapid && maxFeedRate > 0.0) {
+            feedRate = std::min(feedRate, maxFeedRate);
+        }
+        const double cruise = std::max(0.0, feedRate / 60.0);
+
+        const double cosine = previousExit.z * entry.z + previousExit.x * entry.x;
+        const double junction = std::max(0.0, cosine) * std::min(previousCruise, cruise);
+        const bool cutting = move.kind == TMoveKind::Feed || move.kind == TMoveKind::Plunge;
+        profiles.push_back({length, cruise, junction, cutting});
+
+        previousExit = exit;
+        previousCruise = cruise;
+    }
+
+    if (acceleration > 0.0) {
+        // Backward pass: every move has to be able to slow down to what the next one allows,
+        // the toolpath ends at rest
+        double exitLimit = 0.0;
+        for (auto it = profiles.rbegin(); it != profiles.rend(); ++it) {
+            it->entrySpeed = std::min(it->entrySpeed, std::sqrt(exitLimit * exitLimit + 2.0 * acceleration * it->length));
+            exitLimit = it->entrySpeed;
+        }
+    }
+
+    // Forward pass: speed up from the actual entry speed, no faster than the next move allows
+    double entrySpeed = 0.0;
+    for (size_t i = 0; i < profiles.size(); i++) {
+        const MoveProfile& profile = profiles[i];
+        const double exitLimit = i + 1 < profiles.size() ? profiles[i + 1].entrySpeed : 0.0;
+        double exitSpeed = exitLimit;
+        if (acceleration > 0.0) {
+            exitSpeed = std::min(exitLimit, std::sqrt(entrySpeed * entrySpeed + 2.0 * acceleration * profile.length));
+        }
+
+        const double time = moveTime(profile, entrySpeed, exitSpeed);
+        if (profile.cutting) {
+            result.cuttingTime += time;
+        } else {
+            result.positioningTime += time;
+        }
+        entrySpeed = exitSpeed;
+    }
+
+    return result;
+}
+
+double CycleTimeEstimator::moveTime(const MoveProfile& profile, const double entrySpeed, const double exitSpeed) const {
+    const double length = profile.length;
+    const double cruise = profile.cruiseSpeed;
+    if (length <= 0.0 || cruise <= 0.0) {
+        return 0.0;
+    }
+    if (acceleration <= 0.0) {
+        return length / cruise;
+    }
+
+    const double accelerationDistance = (cruise * cruise - entrySpeed * entrySpeed) / (2.0 * acceleration);
+    const double decelerationDistance = (cruise * cruise - exitSpeed * exitSpeed) / (2.0 * acceleration);
+    if (accelerationDistance + decelerationDistance <= length) {
+        // Trapezoid, the move reaches its cruise speed
+        const double cruiseDistance = length - accelerationDistance - decelerationDistance;
+        return (cruise - entrySpeed) / acceleration + (cruise - exitSpeed) / acceleration + cruiseDistance / cruise;
+    }
+
+    // Triangle, the move turns from accelerating to decelerating before reaching cruise speed
+    const double peak = std::sqrt((2.0 * acceleration * length + entrySpeed * entrySpeed + exitSpeed * exitSpeed) / 2.0);
+    return (2.0 * peak - entrySpeed - exitSpeed) / acceleration;
+}
+
+std::string formatCycleTime(const double seconds) {
+    const long long total = std::llround(std::max(0.0, seconds));
+    const long long hours = total / 3600;
+    const long long minutes = total / 60 % 60;
+    if (hours > 0) {
+        return fmt::format("{}:{:02}:{:02}", hours, minutes, total % 60);
+    }
+    return fmt::format("{}:{:02}", minutes, total % 60);
+}
@@ -0,0 +1,84 @@
+//
+// Cycle time estimation for generated toolpaths.
+//
+
+#ifndef TURNLAB_CYCLETIMEESTIMATOR_H
+#define TURNLAB_CYCLETIMEESTIMATOR_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../../model/MachineConfig.h"
+#include "../../model/toolpath/TToolpathSequence.h"
+
+// Times in seconds, split by what the machine is doing
+struct CycleTimeEstimate {
+    // Feed and plunge moves
+    double cuttingTime = 0.0;
+    // Rapid and retract moves
+    double positioningTime = 0.0;
+    double dwellTime = 0.0;
+    double toolChangeTime = 0.0;
+    double spindleTime = 0.0;
+    size_t toolChanges = 0;
+
+    double total() const { return cuttingTime + positioningTime + dwellTime + toolChangeTime + spindleTime; }
+
+    CycleTimeEstimate& operator+=(const CycleTimeEstimate& other);
+};
+
+struct ProjectCycleTime {
+    // One estimate per toolpath sequence, in machining order
+    std::vector<CycleTimeEstimate> operations;
+    CycleTimeEstimate total;
+};
+
+// Adds up move times with a trapezoidal velocity profile. Each move accelerates from its entry
+// speed towards its feed rate and decelerates to its exit speed. The speed carried through a
+// junction is limited by the change of direction, so moves meeting at a corner stop there while
+// tangent moves keep their speed. Rapid moves run at the machine rapid rate, all feeds are
+// capped at the machine maximum. Tool changes and spindle speed changes add their own time.
+// Linear in the number of moves.
+class CycleTimeEstimator {
+public:
+    explicit CycleTimeEstimator(const MachineConfig& machineConfig);
+
+    // The sequence on its own, starting with a tool change and the spindle at rest
+    CycleTimeEstimate estimate(const TToolpathSequence& sequence);
+
+    // Sequences run one after another, tool and spindle speed carry over between them
+    ProjectCycleTime estimateProject(const std::vector<TToolpathSequence>& sequences);
+
+private:
+    struct SpindleState {
+        int toolNumber = -1;
+        double rpm = 0.0;
+    };
+
+    struct MoveProfile {
+        double length;
+        // mm/s
+        double cruiseSpeed;
+        // Highest speed the move may be entered with
+        double entrySpeed;
+        bool cutting;
+    };
+
+    CycleTimeEstimate estimate(const TToolpathSequence& sequence, SpindleState& spindle);
+    double moveTime(const MoveProfile& profile, double entrySpeed, double exitSpeed) const;
+
+    double rapidFeedRate;
+    double maxFeedRate;
+    double acceleration;
+    double spindleAcceleration;
+    double toolChangeTime;
+
+    // Reused between estimates to avoid allocating on every preview
+    std::vector<MoveProfile> profiles;
+};
+
+// Formats seconds as m:ss, or h:mm:ss from an hour on
+std::string formatCycleTime(double seconds);
+
+#endif //TURNLAB_CYCLETIMEESTIMATOR_H
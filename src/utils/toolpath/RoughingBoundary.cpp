@@ -0,0 +1,95 @@
+//
+// Material left above a profile, used to clip roughing passes to where there is stock to cut.
+//
+
+#include "RoughingBoundary.h"
+
+#include <algorithm>
+#include <utility>
+
+RoughingBoundary::RoughingBoundary(const Contour& profile, const double zStart, const double zEnd, const double outward, const double tolerance)
+    : profile(flattenContour(profile, tolerance)), zStart(zStart), zEnd(zEnd), outward(outward), tolerance(tolerance) {
+}
+
+std::vector<PassSpan> RoughingBoundary::spansAt(const double x) const {
+    // Radii measured away from the centerline, a profile within tolerance of the pass does not block it
+    const double level = x * outward + tolerance;
+
+    // Z ranges where the profile rises above the pass
+    std::vector<std::pair<double, double>> blocked;
+    for (size_t i = 1; i < profile.size(); i++) {
+        const TPoint& a = profile[i - 1];
+        const TPoint& b = profile[i];
+        const double ra = a.x * outward;
+        const double rb = b.x * outward;
+        if (ra <= level && rb <= level) {
+            continue;
+        }
+        double from = a.z;
+        double to = b.z;
+        if (ra <= level) {
+            from = a.z + (level - ra) / (rb - ra) * (b.z - a.z);
+        } else if (rb <= level) {
+            to = a.z + (level - ra) / (rb - ra) * (b.z - a.z);
+        }
+        blocked.emplace_back(std::min(from, to), std::max(from, to));
+    }
+    std::sort(blocked.begin(), blocked.end());
+
+    // The stock boundary, with the blocked ranges cut out of it
+    std::vector<PassSpan> spans;
+    double free = std::min(zStart, zEnd);
+    const double last = std::max(zStart, zEnd);
+    for (const auto& [from, to] : blocked) {
+        if (from - free > tolerance) {
+            spans.push_back({free, std::min(from, last)});
+        }
+        free = std::max(free, to);
+        if (free >= last) {
+            break;
+        }
+    }
+    if (last - free > tolerance) {
+        spans.push_back({free, last});
+    }
+    std::erase_if(spans, [&](const PassSpan& span) { return span.end - span.start <= tolerance; });
+
+    if (zStart > zEnd) {
+        std::reverse(spans.begin(), spans.end());
+        for (auto& span : spans) {
+            std::swap(span.start, span.end);
+        }
+    }
+    return spans;
+}
+
+std::vector<double> RoughingBoundary::floors() const {
+    const double first = std::min(zStart, zEnd);
+    const double last = std::max(zStart, zEnd);
+    const auto inRange = [&](const TPoint& point) { return point.z >= first - tolerance && point.z <= last + tolerance; };
+
+    std::vector<double> result;
+    for (size_t i = 1; i < profile.size(); i++) {
+        const TPoint& a = profile[i - 1];
+        const TPoint& b = profile[i];
+        const double overlap = std::min(last, std::max(a.z, b.z)) - std::max(first, std::min(a.z, b.z));
+        if (std::abs(a.x - b.x) <= tolerance && overlap > tolerance) {
+            result.push_back(a.x);
+        }
+    }
+    const TPoint* innermost = nullptr;
+    for (const TPoint& point : profile) {
+        if (inRange(point) && (!innermost || point.x * outward < innermost->x * outward)) {
+            innermost = &point;
+        }
+    }
+    if (innermost) {
+        result.push_back(innermost->x);
+    }
+
+    std::sort(result.begin(), result.end(), [&](const double a, const double b) { return a * outward > b * outward; });
+    result.erase(std::unique(result.begin(), result.end(), [&](const double a, const double b) {
+        return std::abs(a - b) <= tolerance;
+    }), result.end());
+    return result;
+}
@@ -0,0 +1,42 @@
+//
+// Material left above a profile, used to clip roughing passes to where there is stock to cut.
+//
+
+#ifndef TURNLAB_ROUGHINGBOUNDARY_H
+#define TURNLAB_ROUGHINGBOUNDARY_H
+
+#include <vector>
+
+#include "../../model/toolpath/TPoint.h"
+#include "Contour.h"
+
+// Stretch of a pass along Z, start being the end closer to where the passes begin
+struct PassSpan {
+    double start;
+    double end;
+};
+
+// Stock between zStart and zEnd down to the profile. The profile is flattened once, each pass is
+// then clipped in O(n log n) for n profile points. Arcs are followed within tolerance.
+class RoughingBoundary {
+public:
+    // outward is 1 when the stock lies towards positive X, -1 when it lies towards negative X
+    RoughingBoundary(const Contour& profile, double zStart, double zEnd, double outward, double tolerance = DEFAULT_CONTOUR_TOLERANCE);
+
+    // Parts of a pass at x that cut stock without going below the profile, in cutting order.
+    // Empty once the pass is below the whole profile.
+    std::vector<PassSpan> spansAt(double x) const;
+
+    // Levels the profile runs along parallel to the axis within the axial range, and its innermost
+    // point there, from the outermost inwards. A pass at each of them leaves exactly the profile.
+    std::vector<double> floors() const;
+
+private:
+    std::vector<TPoint> profile;
+    double zStart;
+    double zEnd;
+    double outward;
+    double tolerance;
+};
+
+#endif //TURNLAB_ROUGHINGBOUNDARY_H
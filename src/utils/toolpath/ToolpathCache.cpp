@@ -0,0 +1,243 @@
+//
+// Memoizing layer around toolpath generation, keyed by operation and machine configuration.
+//
+
+#include "ToolpathCache.h"
+
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+
+#include "CacheDirectory.h"
+#include "Hash.h"
+#include "ToolpathGenerator.h"
+
+namespace {
+constexpr uint32_t TOOLPATH_MAGIC = 0x50544c54; // "TLTP"
+constexpr uint32_t TOOLPATH_FORMAT_VERSION = 1;
+constexpr auto CACHE_EXTENSION = ".tltp";
+
+template<typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T readValue(std::istream& in) {
+    T value{};
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::runtime_error("Truncated toolpath data");
+    }
+    return value;
+}
+
+uint64_t hashDouble(const uint64_t seed, const double value) {
+    return hashCombine(seed, std::bit_cast<uint64_t>(value));
+}
+}
+
+void writeToolpath(std::ostream& out, const TToolpathSequence& toolpath) {
+    writeValue(out, TOOLPATH_MAGIC);
+    writeValue(out, TOOLPATH_FORMAT_VERSION);
+    writeValue(out, static_cast<uint64_t>(toolpath.size()));
+    writeValue(out, static_cast<uint64_t>(toolpath.states().size()));
+    out.write(reinterpret_cast<const char*>(toolpath.moves().data()),
+              static_cast<std::streamsize>(toolpath.size() * sizeof(TMove)));
+    for (const auto& run : toolpath.states()) {
+        writeValue(out, static_cast<uint64_t>(run.firstMove));
+        writeValue(out, static_cast<int32_t>(run.state.toolNumber));
+        writeValue(out, run.state.feedRate);
+        writeValue(out, run.state.rpm);
+    }
+}
+
+TToolpathSequence readToolpath(std::istream& in) {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!in || magic != TOOLPATH_MAGIC) {
+        throw std::runtime_error("Not a toolpath file");
+    }
+    if (version != TOOLPATH_FORMAT_VERSION) {
+        throw std::runtime_error(fmt::format("Unsupported toolpath format version {}", version));
+    }
+    const auto moveCount = readValue<uint64_t>(in);
+    const auto runCount = readValue<uint64_t>(in);
+
+    // Check the counts against the remaining data before allocating anything
+    const std::streampos position = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto remaining = static_cast<uint64_t>(in.tellg() - position);
+    in.seekg(position);
+    constexpr uint64_t bytesPerRun = sizeof(uint64_t) + sizeof(int32_t) + 2 * sizeof(double);
+    if (moveCount > remaining / sizeof(TMove) || remaining != moveCount * sizeof(TMove) + runCount * bytesPerRun) {
+        throw std::runtime_error("Truncated toolpath data");
+    }
+
+    std::vector<TMove> moves(moveCount);
+    in.read(reinterpret_cast<char*>(moves.data()), static_cast<std::streamsize>(moveCount * sizeof(TMove)));
+    std::vector<TToolpathSequence::StateRun> runs(runCount);
+    for (auto& run : runs) {
+        run.firstMove = readValue<uint64_t>(in);
+        run.state.toolNumber = readValue<int32_t>(in);
+        run.state.feedRate = readValue<double>(in);
+        run.state.rpm = readValue<double>(in);
+    }
+
+    if (moveCount > 0 && (runs.empty() || runs.front().firstMove != 0)) {
+        throw std::runtime_error("Toolpath moves without state");
+    }
+    for (size_t i = 1; i < runs.size(); i++) {
+        if (runs[i].firstMove <= runs[i - 1].firstMove || runs[i].firstMove >= moveCount) {
+            throw std::runtime_error("Invalid toolpath state runs");
+        }
+    }
+
+    TToolpathSequence toolpath;
+    toolpath.reserve(moveCount);
+    size_t run = 0;
+    for (size_t i = 0; i < moves.size(); i++) {
+        const TMove& move = moves[i];
+        if (move.type != TToolpathType::Line && move.type != TToolpathType::Arc) {
+            throw std::runtime_error("Invalid move type in toolpath data");
+        }
+        if (static_cast<uint8_t>(move.kind) > static_cast<uint8_t>(TMoveKind::Dwell)) {
+            throw std::runtime_error("Invalid move kind in toolpath data");
+        }
+        if (run + 1 < runs.size() && runs[run + 1].firstMove == i) {
+            run++;
+        }
+        toolpath.addMove(move, runs[run].state);
+    }
+    return toolpath;
+}
+
+ToolpathCache::ToolpathCache(const size_t maxEntries, std::optional<std::filesystem::path> directory, const uint64_t maxBytes)
+    : maxEntries(maxEntries), directory(std::move(directory)), maxBytes(maxBytes) {
+}
+
+uint64_t ToolpathCache::key(const OperationConfiguration& operation, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    // The JSON form lists every field in a fixed order and round trips doubles exactly
+    uint64_t result = fnv1a(nlohmann::json(operation).dump());
+    result = hashCombine(result, static_cast<uint64_t>(machineConfig.zAxisDirection));
+    result = hashCombine(result, static_cast<uint64_t>(machineConfig.xAxisDirection));
+    result = hashDouble(result, machineConfig.rapidFeedRate);
+    result = hashDouble(result, machineConfig.retractFeedRate);
+    // Only the selected segments shape the toolpath, the selection itself is part of the operation
+    for (const size_t segment : operation.geometrySelection) {
+        if (segment >= geometry.size()) {
+            continue;
+        }
+        result = hashCombine(result, static_cast<uint64_t>(geometry.kinds[segment]));
+        result = hashDouble(result, geometry.x1[segment]);
+        result = hashDouble(result, geometry.y1[segment]);
+        result = hashDouble(result, geometry.x2[segment]);
+        result = hashDouble(result, geometry.y2[segment]);
+        result = hashDouble(result, geometry.bulge[segment]);
+    }
+    result = hashCombine(result, TOOLPATH_GENERATOR_VERSION);
+    return hashCombine(result, TOOLPATH_FORMAT_VERSION);
+}
+
+TToolpathSequence ToolpathCache::generate(const OperationConfiguration& operation, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    const uint64_t toolpathKey = key(operation, machineConfig, geometry);
+    if (std::optional<TToolpathSequence> cached = find(toolpathKey)) {
+        return std::move(*cached);
+    }
+
+    // Generated outside the lock so other operations are not held up
+    TToolpathSequence toolpath = ToolpathGenerator::generateToolpath(operation, machineConfig, geometry);
+    insert(toolpathKey, toolpath);
+    return toolpath;
+}
+
+std::optional<TToolpathSequence> ToolpathCache::find(const uint64_t key) {
+    {
+        std::lock_guard lock(mutex);
+        if (const auto it = index.find(key); it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            hits++;
+            return *it->second->second;
+        }
+    }
+
+    if (directory) {
+        const std::filesystem::path path = pathFor(key);
+        std::ifstream file(path, std::ios::binary);
+        if (file.is_open()) {
+            try {
+                auto toolpath = std::make_shared<const TToolpathSequence>(readToolpath(file));
+                file.close();
+                touchCacheEntry(path);
+                std::lock_guard lock(mutex);
+                insertLocked(key, toolpath);
+                hits++;
+                return *toolpath;
+            } catch (const std::runtime_error& e) {
+                spdlog::warn("Discarding invalid toolpath cache entry {}: {}", path.string(), e.what());
+                file.close();
+                std::error_code error;
+                std::filesystem::remove(path, error);
+            }
+        }
+    }
+
+    std::lock_guard lock(mutex);
+    misses++;
+    return std::nullopt;
+}
+
+void ToolpathCache::insert(const uint64_t key, const TToolpathSequence& toolpath) {
+    {
+        std::lock_guard lock(mutex);
+        insertLocked(key, std::make_shared<const TToolpathSequence>(toolpath));
+    }
+
+    if (directory && writeCacheEntry(pathFor(key), [&](std::ostream& out) { writeToolpath(out, toolpath); })) {
+        evictCacheEntries(*directory, CACHE_EXTENSION, maxBytes);
+    }
+}
+
+void ToolpathCache::insertLocked(const uint64_t key, std::shared_ptr<const TToolpathSequence> toolpath) {
+    if (const auto it = index.find(key); it != index.end()) {
+        it->second->second = std::move(toolpath);
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.emplace_front(key, std::move(toolpath));
+    index[key] = entries.begin();
+    while (entries.size() > maxEntries) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+void ToolpathCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+    index.clear();
+}
+
+size_t ToolpathCache::size() const {
+    std::lock_guard lock(mutex);
+    return entries.size();
+}
+
+uint64_t ToolpathCache::getHits() const {
+    std::lock_guard lock(mutex);
+    return hits;
+}
+
+uint64_t ToolpathCache::getMisses() const {
+    std::lock_guard lock(mutex);
+    return misses;
+}
+
+std::filesystem::path ToolpathCache::pathFor(const uint64_t key) const {
+    return *directory / fmt::format("{:016x}{}", key, CACHE_EXTENSION);
+}
@@ -0,0 +1,74 @@
+//
+// Memoizing layer around toolpath generation, keyed by operation and machine configuration.
+//
+
+#ifndef TURNLAB_TOOLPATHCACHE_H
+#define TURNLAB_TOOLPATHCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "../../model/MachineConfig.h"
+#include "../../model/geometry/SegmentStore.h"
+#include "../../model/operation/OperationConfiguration.h"
+#include "../../model/toolpath/TToolpathSequence.h"
+
+// Number of toolpaths kept in memory
+#define DEFAULT_TOOLPATH_CACHE_ENTRIES 256
+// Upper bound for the total size of the on-disk cache directory, in bytes
+#define DEFAULT_TOOLPATH_DISK_CACHE_SIZE (64ull * 1024 * 1024)
+
+// Keeps generated toolpaths in a least recently used in-memory cache, optionally backed by a
+// directory with one binary file per key. Safe to use from several threads at once.
+class ToolpathCache {
+public:
+    explicit ToolpathCache(size_t maxEntries = DEFAULT_TOOLPATH_CACHE_ENTRIES,
+                           std::optional<std::filesystem::path> directory = std::nullopt,
+                           uint64_t maxBytes = DEFAULT_TOOLPATH_DISK_CACHE_SIZE);
+
+    // Covers the operation, the machine settings the generators read, the selected geometry
+    // segments and the generator version
+    static uint64_t key(const OperationConfiguration& operation, const MachineConfig& machineConfig, const SegmentStore& geometry = {});
+
+    // Cached toolpath for the operation, generated and stored on a miss
+    TToolpathSequence generate(const OperationConfiguration& operation, const MachineConfig& machineConfig, const SegmentStore& geometry = {});
+
+    std::optional<TToolpathSequence> find(uint64_t key);
+    void insert(uint64_t key, const TToolpathSequence& toolpath);
+    void clear();
+
+    size_t size() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+private:
+    using Entry = std::pair<uint64_t, std::shared_ptr<const TToolpathSequence>>;
+
+    std::filesystem::path pathFor(uint64_t key) const;
+    // Caller holds mutex
+    void insertLocked(uint64_t key, std::shared_ptr<const TToolpathSequence> toolpath);
+
+    size_t maxEntries;
+    std::optional<std::filesystem::path> directory;
+    uint64_t maxBytes;
+
+    mutable std::mutex mutex;
+    // Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+// Binary toolpath format, host byte order. readToolpath throws std::runtime_error on invalid data.
+void writeToolpath(std::ostream& out, const TToolpathSequence& toolpath);
+TToolpathSequence readToolpath(std::istream& in);
+
+#endif //TURNLAB_TOOLPATHCACHE_H
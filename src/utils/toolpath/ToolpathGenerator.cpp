@@ -4,18 +4,54 @@
 
 #include "ToolpathGenerator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 #include "../../model/MachineConfig.h"
+#include "ToolpathOptimizer.h"
+#include "ToolpathPasses.h"
 
-TToolpathSequence ToolpathGenerator::generateToolpath(const OperationConfiguration& opConfig, const MachineConfig& machineConfig) {
+namespace {
+TStreamedMove line(const TPoint& start, const TPoint& end, int toolNumber, double feedRate, double rpm, TMoveKind kind = TMoveKind::Feed) {
+    return {{start, end, {}, TToolpathType::Line, kind, false}, {toolNumber, feedRate, rpm}};
+}
+
+TStreamedMove line(const TLine& move) {
+    return line(move.start, move.end, move.toolNumber, move.feedRate, move.rpm, move.kind);
+}
+
+TStreamedMove contourMove(const ContourElement& element, int toolNumber, double feedRate, double rpm) {
+    return {{element.start, element.end, element.center, element.arc ? TToolpathType::Arc : TToolpathType::Line, TMoveKind::Feed, element.clockwise},
+            {toolNumber, feedRate, rpm}};
+}
+}
+
+TToolpathSequence ToolpathGenerator::generateToolpath(const OperationConfiguration& opConfig, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    ToolpathOptimizerResult optimized;
+    optimized.sequence.append(optimizeMoves(streamOperation(opConfig, machineConfig, geometry), {}, &optimized));
+    spdlog::debug("Generated {} moves, {} removed by the optimizer", optimized.sequence.size(), optimized.removed());
+    return std::move(optimized.sequence);
+}
+
+TMoveStream ToolpathGenerator::streamToolpath(const OperationConfiguration& opConfig, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    // The generators emit zero-length and collinear moves for some configurations
+    return optimizeMoves(streamOperation(opConfig, machineConfig, geometry));
+}
+
+TMoveStream ToolpathGenerator::streamOperation(const OperationConfiguration& opConfig, const MachineConfig& machineConfig, const SegmentStore& geometry) {
     switch (opConfig.operationType) {
         case OperationType::Facing:
-            return generateFacingToolPath(opConfig, machineConfig);
+            return streamForDirections<OperationType::Facing>(opConfig, machineConfig, geometry);
         case OperationType::Turning:
-            return generateTurningToolPath(opConfig, machineConfig);
+            return streamForDirections<OperationType::Turning>(opConfig, machineConfig, geometry);
+        case OperationType::Contouring:
+            return streamForDirections<OperationType::Contouring>(opConfig, machineConfig, geometry);
         case OperationType::Parting:
-            return generatePartingToolPath(opConfig, machineConfig);
+            return streamForDirections<OperationType::Parting>(opConfig, machineConfig, geometry);
         // Future cases for other operation types
         default:
             spdlog::error("Unsupported operation type for toolpath generation");
@@ -23,59 +59,128 @@ TToolpathSequence ToolpathGenerator::generateToolpath(const OperationConfigurati
     }
 }
 
-TToolpathSequence ToolpathGenerator::generateFacingToolPath(const OperationConfiguration& opConfig, const MachineConfig &machineConfig) {
+template<OperationType Type>
+TMoveStream ToolpathGenerator::streamForDirections(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    constexpr auto Positive = AxisDirection::Positive;
+    constexpr auto Negative = AxisDirection::Negative;
+    if (machineConfig.zAxisDirection == Positive) {
+        return machineConfig.xAxisDirection == Positive
+                   ? streamSpecialized<Type, Positive, Positive>(config, machineConfig, geometry)
+                   : streamSpecialized<Type, Positive, Negative>(config, machineConfig, geometry);
+    }
+    return machineConfig.xAxisDirection == Positive
+               ? streamSpecialized<Type, Negative, Positive>(config, machineConfig, geometry)
+               : streamSpecialized<Type, Negative, Negative>(config, machineConfig, geometry);
+}
+
+template<OperationType Type, AxisDirection ZDirection, AxisDirection XDirection>
+TMoveStream ToolpathGenerator::streamSpecialized(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    if constexpr (Type == OperationType::Facing) {
+        return streamFacingToolPath<ZDirection>(config, machineConfig);
+    } else if constexpr (Type == OperationType::Turning) {
+        if (!geometry.empty() && !config.geometrySelection.empty()) {
+            try {
+                const Contour profile = offsetContour(buildContour(geometry, config.geometrySelection), config.stockAllowance);
+                const double zStart = config.axialStartPosition + config.axialStartOffset;
+                const double zEnd = config.axialEndPosition + config.axialEndOffset;
+                return streamProfileTurningToolPath<XDirection>(config, machineConfig, RoughingBoundary(profile, zStart, zEnd, -cutSign<XDirection>()));
+            } catch (const std::invalid_argument& e) {
+                spdlog::warn("Turning down to the inner distance, the selected profile cannot be followed: {}", e.what());
+            }
+        }
+        return streamTurningToolPath<XDirection>(config, machineConfig);
+    } else if constexpr (Type == OperationType::Contouring) {
+        // Built up front so the stream does not depend on the project geometry
+        Contour contour;
+        try {
+            contour = buildContour(geometry, config.geometrySelection);
+        } catch (const std::invalid_argument& e) {
+            spdlog::error("Cannot generate contouring toolpath: {}", e.what());
+            return {};
+        }
+        orientTowardsChuck(contour, ZDirection);
+        return streamContouringToolPath(config, machineConfig, offsetContour(contour, config.stockAllowance));
+    } else {
+        static_assert(Type == OperationType::Parting, "No toolpath generator for operation type");
+        return streamPartingToolPath<XDirection>(config, machineConfig);
+    }
+}
+
+TToolpathSequence ToolpathGenerator::generateFacingToolPath(const OperationConfiguration& config, const MachineConfig& machineConfig) {
+    TToolpathSequence toolpath;
+    toolpath.append(streamForDirections<OperationType::Facing>(config, machineConfig, {}));
+    return toolpath;
+}
+
+TToolpathSequence ToolpathGenerator::generateTurningToolPath(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    TToolpathSequence toolpath;
+    toolpath.append(streamForDirections<OperationType::Turning>(config, machineConfig, geometry));
+    return toolpath;
+}
+
+TToolpathSequence ToolpathGenerator::generatePartingToolPath(const OperationConfiguration& config, const MachineConfig& machineConfig) {
+    TToolpathSequence toolpath;
+    toolpath.append(streamForDirections<OperationType::Parting>(config, machineConfig, {}));
+    return toolpath;
+}
+
+TToolpathSequence ToolpathGenerator::generateContouringToolPath(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry) {
+    TToolpathSequence toolpath;
+    toolpath.append(streamForDirections<OperationType::Contouring>(config, machineConfig, geometry));
+    return toolpath;
+}
+
+template<AxisDirection ZDirection>
+TMoveStream ToolpathGenerator::streamFacingToolPath(const OperationConfiguration opConfig, const MachineConfig machineConfig) {
     spdlog::debug("Generating toolpath for operation: {}", toString(opConfig.operationType));
 
     double zStartPos = opConfig.axialStartPosition + opConfig.axialStartOffset;
     double zEndPos = opConfig.axialEndPosition + opConfig.axialEndOffset;
 
+    const DistanceLadder distances = distanceLadder(opConfig);
+    double clearanceDistance = distances.clearance;
+    double retractDistance = distances.retract;
+    double feedDistance = distances.feed;
+    double innerDistance = distances.inner;
 
-    double clearanceDistance = opConfig.outerDistance + opConfig.feedDistance + opConfig.retractDistance + opConfig.clearanceDistance;
-    double retractDistance = opConfig.outerDistance + opConfig.feedDistance + opConfig.retractDistance;
-    double feedDistance = opConfig.outerDistance + opConfig.feedDistance;
-    double innerDistance = opConfig.innerDistance;
-
-    double backoffZDistance = zStartPos - opConfig.backoffDistance * (machineConfig.zAxisDirection == AxisDirection::Positive ? -1 : 1);
+    double backoffZDistance = zStartPos - opConfig.backoffDistance * cutSign<ZDirection>();
 
     TPoint backoffPoint(innerDistance, backoffZDistance);
 
-    size_t numPasses = std::ceil(std::abs(zEndPos - zStartPos) / static_cast<double>(opConfig.stepover));
-    TToolpathSequence toolpath;
+    std::vector<double> passes(passCount(zEndPos - zStartPos, opConfig.stepover) - 1);
+    passPositions<ZDirection>(zStartPos, opConfig.stepover, passes);
 
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(clearanceDistance, backoffZDistance), TPoint(retractDistance, backoffZDistance), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm));
+    co_yield line(TPoint(clearanceDistance, backoffZDistance), TPoint(retractDistance, backoffZDistance), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
 
-    double currentZ = zStartPos;
-    for (size_t i = 0; i < numPasses - 1; i++) {
-        currentZ += opConfig.stepover * (machineConfig.zAxisDirection == AxisDirection::Positive ? -1 : 1);
+    for (const double currentZ : passes) {
         // Move to correct z distance
-        toolpath.addToolpath(std::make_unique<TLine>(TPoint(retractDistance, backoffZDistance), TPoint(retractDistance, currentZ), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm));
+        co_yield line(TPoint(retractDistance, backoffZDistance), TPoint(retractDistance, currentZ), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
         // Move to feed distance
-        toolpath.addToolpath(std::make_unique<TLine>(TPoint(retractDistance, currentZ), TPoint(feedDistance, currentZ), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm));
+        co_yield line(TPoint(retractDistance, currentZ), TPoint(feedDistance, currentZ), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
         // Move to inner distance
-        toolpath.addToolpath(std::make_unique<TLine>(TPoint(feedDistance, currentZ), TPoint(innerDistance, currentZ), opConfig.toolNumber, opConfig.feedrate, opConfig.rpm));
+        co_yield line(TPoint(feedDistance, currentZ), TPoint(innerDistance, currentZ), opConfig.toolNumber, opConfig.feedrate, opConfig.rpm);
         // Move to backoff distance
-        toolpath.addToolpath(std::make_unique<TLine>(TPoint(innerDistance, currentZ), backoffPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm));
+        co_yield line(TPoint(innerDistance, currentZ), backoffPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm, TMoveKind::Retract);
         // Move to retract distance
-        toolpath.addToolpath(std::make_unique<TLine>(backoffPoint, TPoint(retractDistance, backoffZDistance), opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm));
+        co_yield line(backoffPoint, TPoint(retractDistance, backoffZDistance), opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm, TMoveKind::Retract);
     }
 
     // Move to final z position
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(retractDistance, backoffZDistance), TPoint(retractDistance, zEndPos), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm));
+    co_yield line(TPoint(retractDistance, backoffZDistance), TPoint(retractDistance, zEndPos), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
     // Move to feed distance
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(retractDistance, zEndPos), TPoint(feedDistance, zEndPos), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm));
+    co_yield line(TPoint(retractDistance, zEndPos), TPoint(feedDistance, zEndPos), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
     // Move to inner distance
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(feedDistance, zEndPos), TPoint(innerDistance, zEndPos), opConfig.toolNumber, opConfig.feedrate, opConfig.rpm));
+    co_yield line(TPoint(feedDistance, zEndPos), TPoint(innerDistance, zEndPos), opConfig.toolNumber, opConfig.feedrate, opConfig.rpm);
     // Move to backoff distance
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(innerDistance, zEndPos), backoffPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm));
+    co_yield line(TPoint(innerDistance, zEndPos), backoffPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm, TMoveKind::Retract);
     // Move to retract distance
-    toolpath.addToolpath(std::make_unique<TLine>(backoffPoint, TPoint(retractDistance, backoffZDistance), opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm));
+    co_yield line(backoffPoint, TPoint(retractDistance, backoffZDistance), opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm, TMoveKind::Retract);
     // Move to clearance distance
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(retractDistance, backoffZDistance), TPoint(clearanceDistance, backoffZDistance), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm));
-
-    return toolpath;
+    co_yield line(TPoint(retractDistance, backoffZDistance), TPoint(clearanceDistance, backoffZDistance), opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
 }
 
-TToolpathSequence ToolpathGenerator::generateTurningToolPath(const OperationConfiguration &config, const MachineConfig& machineConfig) {
+template<AxisDirection XDirection>
+TMoveStream ToolpathGenerator::streamTurningToolPath(const OperationConfiguration config, const MachineConfig machineConfig) {
     spdlog::debug("Generating toolpath for operation: {}", toString(config.operationType));
     // turning consists of several straight moves
     // 1. move from retract to clearance distance
@@ -96,11 +201,12 @@ TToolpathSequence ToolpathGenerator::generateTurningToolPath(const OperationConf
     double zStart = config.axialStartPosition + config.axialStartOffset;
     double zEnd = config.axialEndPosition + config.axialEndOffset;
 
-    double clearanceDistance = config.outerDistance + config.feedDistance + config.retractDistance + config.clearanceDistance;
-    double retractDistance = config.outerDistance + config.feedDistance + config.retractDistance;
-    double feedDistance = config.outerDistance + config.feedDistance;
-    double outerDistance = config.outerDistance;
-    double innerDistance = config.innerDistance;
+    const DistanceLadder distances = distanceLadder(config);
+    double clearanceDistance = distances.clearance;
+    double retractDistance = distances.retract;
+    double feedDistance = distances.feed;
+    double outerDistance = distances.outer;
+    double innerDistance = distances.inner;
 
     TPoint clearanceStartPoint = {clearanceDistance, zStart};
     TPoint retractStartPoint = {retractDistance, zStart};
@@ -109,71 +215,227 @@ TToolpathSequence ToolpathGenerator::generateTurningToolPath(const OperationConf
     TPoint retractEndPoint = {retractDistance, zEnd};
     TPoint clearanceEndPoint = {clearanceDistance, zEnd};
 
-    TToolpathSequence toolpath;
-
-    size_t numPasses = std::ceil(std::abs(outerDistance - innerDistance) / static_cast<double>(config.stepover));
+    std::vector<double> passes(passCount(outerDistance - innerDistance, config.stepover) - 1);
+    passPositions<XDirection>(outerDistance, config.stepover, passes);
 
-    toolpath.addToolpath(std::make_unique<TLine>(clearanceStartPoint, retractStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm));
+    co_yield line(clearanceStartPoint, retractStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
 
-    double currentDistance = outerDistance;
-    for (size_t i = 0; i < numPasses - 1; i++) {
+    for (const double currentDistance : passes) {
         // move to feed distance
-        toolpath.addToolpath(std::make_unique<TLine>(retractStartPoint, feedStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm));
+        co_yield line(retractStartPoint, feedStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
         // move to current outer distance + step over
-        currentDistance += config.stepover * (machineConfig.xAxisDirection == AxisDirection::Positive ? -1 : 1);
-        toolpath.addToolpath(std::make_unique<TLine>(feedStartPoint, TPoint(currentDistance, zStart), toolNumber, feedrate, rpm));
+        co_yield line(feedStartPoint, TPoint(currentDistance, zStart), toolNumber, feedrate, rpm, TMoveKind::Plunge);
         // move to z end
-        toolpath.addToolpath(std::make_unique<TLine>(TPoint(currentDistance, zStart), TPoint(currentDistance, zEnd), toolNumber, feedrate, rpm));
+        co_yield line(TPoint(currentDistance, zStart), TPoint(currentDistance, zEnd), toolNumber, feedrate, rpm);
         // move out to retract distance
-        toolpath.addToolpath(std::make_unique<TLine>(TPoint(currentDistance, zEnd), retractEndPoint, toolNumber, machineConfig.retractFeedRate, rpm));
+        co_yield line(TPoint(currentDistance, zEnd), retractEndPoint, toolNumber, machineConfig.retractFeedRate, rpm, TMoveKind::Retract);
         // move to start position
-        toolpath.addToolpath(std::make_unique<TLine>(retractEndPoint, retractStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm));
+        co_yield line(retractEndPoint, retractStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
     }
 
     // move to feed distance
-    toolpath.addToolpath(std::make_unique<TLine>(retractStartPoint, feedStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm));
+    co_yield line(retractStartPoint, feedStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
     // move to final distance
-    toolpath.addToolpath(std::make_unique<TLine>(feedStartPoint, TPoint(innerDistance, zStart), toolNumber, feedrate, rpm));
+    co_yield line(feedStartPoint, TPoint(innerDistance, zStart), toolNumber, feedrate, rpm, TMoveKind::Plunge);
     // move to z end
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(innerDistance, zStart), TPoint(innerDistance, zEnd), toolNumber, feedrate, rpm));
+    co_yield line(TPoint(innerDistance, zStart), TPoint(innerDistance, zEnd), toolNumber, feedrate, rpm);
     // move out to retract distance
-    toolpath.addToolpath(std::make_unique<TLine>(TPoint(innerDistance, zEnd), retractEndPoint, toolNumber, machineConfig.retractFeedRate, rpm));
+    co_yield line(TPoint(innerDistance, zEnd), retractEndPoint, toolNumber, machineConfig.retractFeedRate, rpm, TMoveKind::Retract);
     // move out to clearance distance
-    toolpath.addToolpath(std::make_unique<TLine>(retractEndPoint, clearanceEndPoint, toolNumber, machineConfig.rapidFeedRate, rpm));
+    co_yield line(retractEndPoint, clearanceEndPoint, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+}
 
-    return toolpath;
+template<AxisDirection XDirection>
+TMoveStream ToolpathGenerator::streamProfileTurningToolPath(const OperationConfiguration config, const MachineConfig machineConfig, const RoughingBoundary boundary) {
+    spdlog::debug("Generating toolpath for operation: {} following the profile", toString(config.operationType));
+    // roughing passes as for turning, each cut only where stock is left above the profile
+    // 1. move from clearance to retract distance
+    // 2. move above the start of the span
+    // 3. move to feed distance above the previous pass
+    // 4. plunge to the current pass
+    // 5. move to the end of the span
+    // 6. back off to retract distance
+    // goto 2 for the next span, then for the next pass
+    // if no span is left:
+    // 7. move to clearance distance
+
+    int toolNumber = config.toolNumber;
+    double feedrate = config.feedrate;
+    double rpm = config.rpm;
+
+    double zStart = config.axialStartPosition + config.axialStartOffset;
+
+    const DistanceLadder distances = distanceLadder(config);
+    double clearanceDistance = distances.clearance;
+    double retractDistance = distances.retract;
+    double outerDistance = distances.outer;
+    double innerDistance = distances.inner;
+
+    // The passes end on the innermost floor of the profile, allowance included, unless the inner
+    // distance stops them first. Every floor in between gets a pass of its own, so no more than
+    // the allowance is left on it whatever the stepover.
+    const double outward = -cutSign<XDirection>();
+    const std::vector<double> floors = boundary.floors();
+    double lowestDistance = innerDistance;
+    if (!floors.empty() && floors.back() * outward > innerDistance * outward) {
+        lowestDistance = floors.back();
+    }
+    std::vector<double> passes(passCount(outerDistance - lowestDistance, config.stepover));
+    passPositions<XDirection>(outerDistance, config.stepover, std::span(passes).first(passes.size() - 1));
+    passes.back() = lowestDistance;
+    for (const double floor : floors) {
+        if (floor * outward > lowestDistance * outward && floor * outward < outerDistance * outward) {
+            passes.push_back(floor);
+        }
+    }
+    std::sort(passes.begin(), passes.end(), [&](const double a, const double b) { return a * outward > b * outward; });
+    passes.erase(std::unique(passes.begin(), passes.end(), [](const double a, const double b) {
+        return std::abs(a - b) <= DEFAULT_CONTOUR_TOLERANCE;
+    }), passes.end());
+
+    TPoint position(retractDistance, zStart);
+    co_yield line(TPoint(clearanceDistance, zStart), position, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+
+    // Stock is left up to the previous pass wherever the current one cuts, spans only shrink
+    double previousDistance = outerDistance;
+    for (const double currentDistance : passes) {
+        const std::vector<PassSpan> spans = boundary.spansAt(currentDistance);
+        if (spans.empty()) {
+            break;
+        }
+        const double approachDistance = previousDistance - cutSign<XDirection>() * config.feedDistance;
+        for (const PassSpan& span : spans) {
+            // move above the span
+            co_yield line(position, TPoint(retractDistance, span.start), toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+            // move to feed distance above the previous pass
+            co_yield line(TPoint(retractDistance, span.start), TPoint(approachDistance, span.start), toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+            // move to current distance
+            co_yield line(TPoint(approachDistance, span.start), TPoint(currentDistance, span.start), toolNumber, feedrate, rpm, TMoveKind::Plunge);
+            // move to the end of the span
+            co_yield line(TPoint(currentDistance, span.start), TPoint(currentDistance, span.end), toolNumber, feedrate, rpm);
+            // move out to retract distance
+            position = TPoint(retractDistance, span.end);
+            co_yield line(TPoint(currentDistance, span.end), position, toolNumber, machineConfig.retractFeedRate, rpm, TMoveKind::Retract);
+        }
+        previousDistance = currentDistance;
+    }
+
+    // move out to clearance distance
+    co_yield line(position, TPoint(clearanceDistance, position.z), toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
 }
 
-TToolpathSequence ToolpathGenerator::generatePartingToolPath(const OperationConfiguration& opConfig, const MachineConfig& machineConfig) {
+template<AxisDirection XDirection>
+TMoveStream ToolpathGenerator::streamPartingToolPath(const OperationConfiguration opConfig, const MachineConfig machineConfig) {
     spdlog::debug("Generating toolpath for operation: {}", toString(opConfig.operationType));
 
     double zPos = opConfig.axialStartPosition + opConfig.axialStartOffset;
-    TPoint clearancePoint(opConfig.outerDistance + opConfig.feedDistance + opConfig.retractDistance + opConfig.clearanceDistance, zPos);
-    TPoint retractPoint(opConfig.outerDistance + opConfig.feedDistance + opConfig.retractDistance, zPos);
-    TPoint feedPoint(opConfig.outerDistance + opConfig.feedDistance, zPos);
-    TPoint outerPoint(opConfig.outerDistance, zPos);
-    TPoint innerPoint(opConfig.innerDistance, zPos);
+    const DistanceLadder distances = distanceLadder(opConfig);
+    TPoint clearancePoint(distances.clearance, zPos);
+    TPoint retractPoint(distances.retract, zPos);
+    TPoint feedPoint(distances.feed, zPos);
+    TPoint outerPoint(distances.outer, zPos);
+    TPoint innerPoint(distances.inner, zPos);
+
+
+    TLine c2r(clearancePoint, retractPoint, opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
+    TLine r2f(retractPoint, feedPoint, opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
+    TLine r2c(retractPoint, clearancePoint, opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm, TMoveKind::Rapid);
+
+    co_yield line(c2r);
+
+    std::vector<double> passes(passCount(outerPoint.x - innerPoint.x, opConfig.cutDepthPerPass) - 1);
+    passPositions<XDirection>(outerPoint.x, opConfig.cutDepthPerPass, passes);
+    for (const double currentX : passes) {
+        co_yield line(r2f);
+        co_yield line(feedPoint, TPoint(currentX, zPos), opConfig.toolNumber, opConfig.feedrate, opConfig.rpm);
+        co_yield line(TPoint(currentX, zPos), retractPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm, TMoveKind::Retract);
+    }
+    co_yield line(r2f);
+    co_yield line(feedPoint, innerPoint, opConfig.toolNumber, opConfig.feedrate, opConfig.rpm);
+    co_yield line(innerPoint, retractPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm, TMoveKind::Retract);
+    co_yield line(r2c);
+}
 
+TMoveStream ToolpathGenerator::streamContouringToolPath(const OperationConfiguration config, const MachineConfig machineConfig, const Contour contour) {
+    spdlog::debug("Generating toolpath for operation: {} with {} elements", toString(config.operationType), contour.size());
+    // contouring follows the profile, repeated for every spring pass
+    // 1. move from clearance to retract distance above the lead-in
+    // 2. move down to the lead-in point, feed distance back along the start direction and away from
+    //    the stock, on the air side of the part and never past the centerline
+    // 3. lead in to the start of the contour
+    // 4. follow the contour
+    // 5. lead out along its end direction and away from the stock
+    // 6. back off to retract distance
+    // 7. move back above the lead-in
+    // goto 2
+    // after the last pass:
+    // 8. move to clearance distance
+    if (contour.empty()) {
+        co_return;
+    }
 
-    TLine c2r(clearancePoint, retractPoint, opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm);
-    TLine r2f(retractPoint, feedPoint, opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm);
-    TLine r2c(retractPoint, clearancePoint, opConfig.toolNumber, machineConfig.rapidFeedRate, opConfig.rpm);
+    int toolNumber = config.toolNumber;
+    double feedrate = config.feedrate;
+    double rpm = config.rpm;
 
-    TToolpathSequence toolpath;
-    toolpath.addToolpath(std::make_unique<TLine>(c2r));
-
-    size_t numPasses = std::ceil(std::abs(outerPoint.x - innerPoint.x) / opConfig.cutDepthPerPass);
-    double currentX = outerPoint.x;
-    for (size_t i = 0; i < numPasses - 1; i++) {
-        toolpath.addToolpath(std::make_unique<TLine>(r2f));
-        currentX += opConfig.cutDepthPerPass * (machineConfig.xAxisDirection == AxisDirection::Positive ? -1 : 1);
-        toolpath.addToolpath(std::make_unique<TLine>(feedPoint, TPoint(currentX, zPos), opConfig.toolNumber, opConfig.feedrate, opConfig.rpm));
-        toolpath.addToolpath(std::make_unique<TLine>(TPoint(currentX, zPos), retractPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm));
+    // Radial side and extent of the profile, arcs may bulge past their endpoints
+    double outermost = 0.0;
+    double outward = 1.0;
+    for (const auto& element : contour) {
+        for (const TPoint& point : {element.start, element.end}) {
+            if (std::abs(point.x) > outermost) {
+                outermost = std::abs(point.x);
+                outward = point.x >= 0.0 ? 1.0 : -1.0;
+            }
+        }
+        if (element.arc) {
+            const double radius = std::hypot(element.start.x - element.center.x, element.start.z - element.center.z);
+            outermost = std::max(outermost, std::abs(element.center.x) + radius);
+        }
+    }
+    double retractDistance = outward * (outermost + config.feedDistance + config.retractDistance);
+    double clearanceDistance = outward * (outermost + config.feedDistance + config.retractDistance + config.clearanceDistance);
+
+    // Dropping straight onto the start along its tangent would run along a face the contour
+    // begins with, so the lead points are moved off the part along the normal facing the air
+    const double side = outwardSide(contour);
+    const auto airSide = [&](const TPoint& direction) { return TPoint(side * direction.z, -side * direction.x); };
+    const auto notPastCenterline = [&](TPoint point) {
+        if (point.x * outward < 0.0) {
+            point.x = 0.0;
+        }
+        return point;
+    };
+
+    const TPoint start = contour.front().start;
+    const TPoint end = contour.back().end;
+    const TPoint startTangent = startDirection(contour.front());
+    const TPoint endTangent = endDirection(contour.back());
+    const TPoint startNormal = airSide(startTangent);
+    const TPoint endNormal = airSide(endTangent);
+    TPoint leadIn = notPastCenterline(TPoint(start.x + (startNormal.x - startTangent.x) * config.feedDistance,
+                                       start.z + (startNormal.z - startTangent.z) * config.feedDistance));
+    TPoint leadOut = notPastCenterline(TPoint(end.x + (endNormal.x + endTangent.x) * config.feedDistance,
+                                        end.z + (endNormal.z + endTangent.z) * config.feedDistance));
+
+    TPoint retractStartPoint(retractDistance, leadIn.z);
+    TPoint retractEndPoint(retractDistance, leadOut.z);
+
+    co_yield line(TPoint(clearanceDistance, leadIn.z), retractStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+
+    const int passes = 1 + std::max(0, config.springPasses);
+    for (int pass = 0; pass < passes; pass++) {
+        co_yield line(retractStartPoint, leadIn, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+        co_yield line(leadIn, start, toolNumber, feedrate, rpm, TMoveKind::Plunge);
+        for (const auto& element : contour) {
+            co_yield contourMove(element, toolNumber, feedrate, rpm);
+        }
+        co_yield line(end, leadOut, toolNumber, feedrate, rpm, TMoveKind::Retract);
+        co_yield line(leadOut, retractEndPoint, toolNumber, machineConfig.retractFeedRate, rpm, TMoveKind::Retract);
+        if (pass + 1 < passes) {
+            co_yield line(retractEndPoint, retractStartPoint, toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+        }
     }
-    toolpath.addToolpath(std::make_unique<TLine>(r2f));
-    toolpath.addToolpath(std::make_unique<TLine>(feedPoint, innerPoint, opConfig.toolNumber, opConfig.feedrate, opConfig.rpm));
-    toolpath.addToolpath(std::make_unique<TLine>(innerPoint, retractPoint, opConfig.toolNumber, machineConfig.retractFeedRate, opConfig.rpm));
-    toolpath.addToolpath(std::make_unique<TLine>(r2c));
 
-    return toolpath;
-}
\ No newline at end of file
+    co_yield line(retractEndPoint, TPoint(clearanceDistance, leadOut.z), toolNumber, machineConfig.rapidFeedRate, rpm, TMoveKind::Rapid);
+}
@@ -7,18 +7,54 @@
 
 
 #include "../../model/MachineConfig.h"
+#include "../../model/geometry/SegmentStore.h"
 #include "../../model/operation/OperationConfiguration.h"
 #include "../../model/toolpath/Toolpath.h"
+#include "Contour.h"
+#include "RoughingBoundary.h"
+
+// Bump whenever generated toolpaths change for the same input, invalidates cached toolpaths
+#define TOOLPATH_GENERATOR_VERSION 6
 
 class ToolpathGenerator {
 
 public:
 
-    static TToolpathSequence generateToolpath(const OperationConfiguration& config, const MachineConfig& machine_config);
+    // Geometry is the project's, operations following a profile read their selected segments from it
+    static TToolpathSequence generateToolpath(const OperationConfiguration& config, const MachineConfig& machine_config, const SegmentStore& geometry = {});
 
     static TToolpathSequence generateFacingToolPath(const OperationConfiguration& config, const MachineConfig &machineConfig);
-    static TToolpathSequence generateTurningToolPath(const OperationConfiguration& config, const MachineConfig& machine_config);
+    // Roughs down to the selected profile when there is one, otherwise down to the inner distance
+    static TToolpathSequence generateTurningToolPath(const OperationConfiguration& config, const MachineConfig& machine_config, const SegmentStore& geometry = {});
     static TToolpathSequence generatePartingToolPath(const OperationConfiguration &opConfig, const MachineConfig &machineConfig);
+    static TToolpathSequence generateContouringToolPath(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry);
+
+    // Optimized moves of the operation, produced as they are consumed. The stream keeps its own
+    // copy of the configurations.
+    static TMoveStream streamToolpath(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry = {});
+
+private:
+    static TMoveStream streamOperation(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry);
+
+    // Picks the instantiation for the machine's axis directions, once per operation
+    template<OperationType Type>
+    static TMoveStream streamForDirections(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry);
+    template<OperationType Type, AxisDirection ZDirection, AxisDirection XDirection>
+    static TMoveStream streamSpecialized(const OperationConfiguration& config, const MachineConfig& machineConfig, const SegmentStore& geometry);
+
+    // Coroutines, the configurations are taken by value so they live in the coroutine frame.
+    // Each is specialized on the axis direction it steps along.
+    template<AxisDirection ZDirection>
+    static TMoveStream streamFacingToolPath(OperationConfiguration config, MachineConfig machineConfig);
+    template<AxisDirection XDirection>
+    static TMoveStream streamTurningToolPath(OperationConfiguration config, MachineConfig machineConfig);
+    // Turning passes clipped to the stock left above the profile, flattened up front
+    template<AxisDirection XDirection>
+    static TMoveStream streamProfileTurningToolPath(OperationConfiguration config, MachineConfig machineConfig, RoughingBoundary boundary);
+    template<AxisDirection XDirection>
+    static TMoveStream streamPartingToolPath(OperationConfiguration opConfig, MachineConfig machineConfig);
+    // Follows the contour, already oriented and offset, so no reference to the geometry is kept
+    static TMoveStream streamContouringToolPath(OperationConfiguration config, MachineConfig machineConfig, Contour contour);
 };
 
 
@@ -0,0 +1,92 @@
+//
+// Post-generation cleanup of toolpath sequences.
+//
+
+#include "ToolpathOptimizer.h"
+
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+double distance(const TPoint& a, const TPoint& b) {
+    return std::hypot(b.x - a.x, b.z - a.z);
+}
+
+// Unit direction from start to end, the caller makes sure they differ
+TPoint direction(const TPoint& start, const TPoint& end) {
+    const double length = distance(start, end);
+    return {(end.x - start.x) / length, (end.z - start.z) / length};
+}
+
+// Distance of point from the line through start along a unit direction
+double deviation(const TPoint& point, const TPoint& start, const TPoint& unit) {
+    return std::abs(unit.x * (point.z - start.z) - unit.z * (point.x - start.x));
+}
+
+bool isLine(const TMove& move) {
+    return move.type == TToolpathType::Line && move.kind != TMoveKind::Dwell;
+}
+
+}
+
+TMoveStream optimizeMoves(TMoveStream moves, const ToolpathOptimizerOptions options, ToolpathOptimizerResult* counts) {
+    ToolpathOptimizerResult local;
+    ToolpathOptimizerResult& result = counts ? *counts : local;
+    const double tolerance = options.tolerance;
+
+    // Line being extended and the direction of the first line of its run. Every absorbed point is
+    // checked once against that fixed direction with half the tolerance, so the final line, whose
+    // end is within half the tolerance as well, stays within tolerance of all of them. Linear in
+    // the length of the run.
+    bool pending = false;
+    TStreamedMove current;
+    TPoint runDirection;
+
+    for (const TStreamedMove& streamed : moves) {
+        const TMove& move = streamed.move;
+        if (isLine(move) && distance(move.start, move.end) <= tolerance) {
+            result.zeroLengthRemoved++;
+            continue;
+        }
+        if (!isLine(move)) {
+            if (pending) {
+                pending = false;
+                co_yield current;
+            }
+            co_yield streamed;
+            continue;
+        }
+
+        if (pending && move.kind == current.move.kind && streamed.state == current.state &&
+            distance(current.move.end, move.start) <= tolerance) {
+            // Same direction, a reversal would retrace the line instead of continuing it
+            const double dot = runDirection.x * (move.end.x - move.start.x) + runDirection.z * (move.end.z - move.start.z);
+            if (dot > 0.0 && deviation(move.end, current.move.start, runDirection) <= tolerance / 2.0) {
+                current.move.end = move.end;
+                result.collinearMerged++;
+                continue;
+            }
+        }
+
+        if (pending) {
+            co_yield current;
+        }
+        current = streamed;
+        runDirection = direction(move.start, move.end);
+        pending = true;
+    }
+    if (pending) {
+        co_yield current;
+    }
+}
+
+ToolpathOptimizerResult optimizeToolpath(const TToolpathSequence& sequence, const ToolpathOptimizerOptions& options) {
+    ToolpathOptimizerResult result;
+    result.sequence.reserve(sequence.size());
+    result.sequence.append(optimizeMoves(streamMoves(sequence), options, &result));
+
+    spdlog::debug("Toolpath optimizer removed {} zero-length and merged {} collinear moves",
+                  result.zeroLengthRemoved, result.collinearMerged);
+    return result;
+}
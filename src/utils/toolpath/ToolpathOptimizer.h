@@ -0,0 +1,40 @@
+//
+// Post-generation cleanup of toolpath sequences.
+//
+
+#ifndef TURNLAB_TOOLPATHOPTIMIZER_H
+#define TURNLAB_TOOLPATHOPTIMIZER_H
+
+#include <cstddef>
+
+#include "../../model/toolpath/TToolpathSequence.h"
+
+// Default tolerance for generated toolpaths in mm, well below machine resolution
+#define DEFAULT_TOOLPATH_TOLERANCE 1e-4
+
+struct ToolpathOptimizerOptions {
+    // Moves shorter than this are dropped, lines deviating less than this from a merged line are absorbed
+    double tolerance = DEFAULT_TOOLPATH_TOLERANCE;
+};
+
+struct ToolpathOptimizerResult {
+    TToolpathSequence sequence;
+    // Lines with coinciding start and end
+    size_t zeroLengthRemoved = 0;
+    // Lines absorbed into the preceding collinear line
+    size_t collinearMerged = 0;
+
+    size_t removed() const { return zeroLengthRemoved + collinearMerged; }
+};
+
+// Drops zero-length lines and merges consecutive collinear lines running in the same direction
+// with the same kind, tool, feed and spindle speed. Every point of a merged run stays within
+// tolerance of the resulting line. Arcs and dwells are kept as they are and move order is
+// unchanged, so the cut geometry is preserved.
+ToolpathOptimizerResult optimizeToolpath(const TToolpathSequence& sequence, const ToolpathOptimizerOptions& options = {});
+
+// Streaming form of the same pass. Counts, if given, receive the removed move counts and have
+// to outlive the stream, their sequence is left untouched.
+TMoveStream optimizeMoves(TMoveStream moves, ToolpathOptimizerOptions options = {}, ToolpathOptimizerResult* counts = nullptr);
+
+#endif //TURNLAB_TOOLPATHOPTIMIZER_H
@@ -0,0 +1,56 @@
+//
+// Axis direction specialized building blocks shared by the toolpath generators.
+//
+
+#ifndef TURNLAB_TOOLPATHPASSES_H
+#define TURNLAB_TOOLPATHPASSES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "../../model/MachineConfig.h"
+#include "../../model/operation/OperationConfiguration.h"
+
+// Sign of a step into the stock along an axis, cutting moves against a positive axis
+template<AxisDirection Direction>
+constexpr double cutSign() {
+    return Direction == AxisDirection::Positive ? -1.0 : 1.0;
+}
+
+// Radial distances the generators move between, from the outermost inwards
+struct DistanceLadder {
+    double clearance;
+    double retract;
+    double feed;
+    double outer;
+    double inner;
+};
+
+inline DistanceLadder distanceLadder(const OperationConfiguration& config) {
+    const double feed = config.outerDistance + config.feedDistance;
+    const double retract = feed + config.retractDistance;
+    return {retract + config.clearanceDistance, retract, feed, config.outerDistance, config.innerDistance};
+}
+
+// Passes needed to cover the distance, at least one so the final pass is always made
+inline size_t passCount(const double distance, const double step) {
+    return std::max<size_t>(1, static_cast<size_t>(std::ceil(std::abs(distance) / step)));
+}
+
+// Fills in the positions of the passes before the final one, each a step further into the stock
+// than the last. Each position is computed from the start rather than accumulated, and the index
+// is a 32-bit int, so there is no loop-carried dependency and the loop vectorizes. A runtime sign
+// would vectorize just as well, the template only keeps the direction in the callers' types.
+template<AxisDirection Direction>
+void passPositions(const double start, const double step, std::span<double> positions) {
+    const double delta = cutSign<Direction>() * step;
+    const int count = static_cast<int>(positions.size());
+    double* out = positions.data();
+    for (int i = 0; i < count; i++) {
+        out[i] = start + delta * (i + 1);
+    }
+}
+
+#endif //TURNLAB_TOOLPATHPASSES_H
@@ -4,6 +4,9 @@
 
 #include "DXFImportDialog.h"
 
+#include <algorithm>
+#include <QSignalBlocker>
+
 DXFImportDialog::DXFImportDialog(const MachineConfig& config, QWidget *parent) : machineConfig(config), QDialog(parent) {
     setWindowTitle("DXF Import Configuration");
     setModal(true);
@@ -36,6 +39,19 @@ void DXFImportDialog::setupLayout() {
 
     mainLayout->addWidget(splitter);
 
+    // Progress of the background DXF import, hidden once the file is loaded
+    importWidget = new QWidget(this);
+    auto* importLayout = new QHBoxLayout(importWidget);
+    importLayout->setContentsMargins(0, 0, 0, 0);
+    importStatusLabel = new QLabel("Reading DXF file...", importWidget);
+    importProgressBar = new QProgressBar(importWidget);
+    importProgressBar->setRange(0, 1000);
+    importProgressBar->setTextVisible(false);
+    importLayout->addWidget(importStatusLabel);
+    importLayout->addWidget(importProgressBar, 1);
+    importWidget->setVisible(false);
+    mainLayout->addWidget(importWidget);
+
     // Create custom button panel for the bottom
     auto* buttonLayout = new QHBoxLayout();
 
@@ -143,6 +159,43 @@ void DXFImportDialog::setupGeometryPanel() {
     connect(unitsCombo, QOverload<const QString&>::of(&QComboBox::currentTextChanged), [this](const QString& text) { emit onUnitsChanged(text); });
     formLayout->addRow("Units:", unitsCombo);
 
+    // Layers to import, filled once the file has been scanned
+    layerList = new QListWidget(this);
+    layerList->setToolTip("Uncheck layers to leave them out of the import");
+    connect(layerList, &QListWidget::itemChanged, [this]() {
+        QStringList keptLayers;
+        for (int i = 0; i < layerList->count(); i++) {
+            const QListWidgetItem* item = layerList->item(i);
+            if (item->checkState() == Qt::Checked) {
+                keptLayers.append(item->data(Qt::UserRole).toString());
+            }
+        }
+        emit layerSelectionChanged(keptLayers);
+    });
+    formLayout->addRow("Layers:", layerList);
+
+    importSummaryLabel = new QLabel(this);
+    importSummaryLabel->setWordWrap(true);
+    formLayout->addRow("Cleanup:", importSummaryLabel);
+
+    // Simplification, applied on import with the default tolerance and again on demand
+    simplifyToleranceSpinBox = new QDoubleSpinBox(this);
+    simplifyToleranceSpinBox->setRange(0.0, 10.0);
+    simplifyToleranceSpinBox->setDecimals(4);
+    simplifyToleranceSpinBox->setSingleStep(0.001);
+    simplifyToleranceSpinBox->setSuffix(" mm");
+    simplifyToleranceSpinBox->setValue(DEFAULT_SIMPLIFY_TOLERANCE);
+    simplifyButton = new QPushButton("Simplify", this);
+    connect(simplifyButton, &QPushButton::clicked, [this]() { emit simplifyRequested(simplifyToleranceSpinBox->value()); });
+    QHBoxLayout* simplifyLayout = new QHBoxLayout();
+    simplifyLayout->addWidget(simplifyToleranceSpinBox);
+    simplifyLayout->addWidget(simplifyButton);
+    formLayout->addRow("Simplify:", simplifyLayout);
+
+    simplifySummaryLabel = new QLabel(this);
+    simplifySummaryLabel->setWordWrap(true);
+    formLayout->addRow("", simplifySummaryLabel);
+
     geometryWidget->setLayout(formLayout);
 }
 
@@ -213,6 +266,53 @@ void DXFImportDialog::setGeometry(const Geometry& geometry) {
     geometryView->setGeometry(geometry);
 }
 
+void DXFImportDialog::setLayers(const std::vector<DXFLayerStatistics>& layers, const std::vector<std::string>& keptLayers) {
+    const QSignalBlocker blocker(layerList);
+    layerList->clear();
+    for (const DXFLayerStatistics& layer : layers) {
+        auto* item = new QListWidgetItem(QString("%1 (%2 segments, %3 entities)")
+                                             .arg(QString::fromStdString(layer.name))
+                                             .arg(layer.segments)
+                                             .arg(layer.entities), layerList);
+        item->setData(Qt::UserRole, QString::fromStdString(layer.name));
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        const bool kept = keptLayers.empty() || std::ranges::find(keptLayers, layer.name) != keptLayers.end();
+        item->setCheckState(kept ? Qt::Checked : Qt::Unchecked);
+    }
+}
+
+void DXFImportDialog::setImportSummary(const QString& summary) {
+    importSummaryLabel->setText(summary);
+}
+
+void DXFImportDialog::setSimplifySummary(const QString& summary) {
+    simplifySummaryLabel->setText(summary);
+}
+
+double DXFImportDialog::getSimplifyTolerance() const {
+    return simplifyToleranceSpinBox->value();
+}
+
+void DXFImportDialog::setImportRunning(const bool running) {
+    importWidget->setVisible(running);
+    nextButton->setEnabled(!running);
+    simplifyButton->setEnabled(!running);
+    if (running) {
+        importProgressBar->setValue(0);
+        importStatusLabel->setText("Reading DXF file...");
+    }
+}
+
+void DXFImportDialog::setImportProgress(const qint64 bytesRead, const qint64 totalBytes, const qint64 entities) {
+    if (totalBytes > 0) {
+        importProgressBar->setValue(static_cast<int>(std::min<qint64>(1000, bytesRead * 1000 / totalBytes)));
+    }
+    importStatusLabel->setText(QString("Reading DXF file: %1 entities, %2 of %3 MB")
+                                   .arg(entities)
+                                   .arg(static_cast<double>(bytesRead) / (1024.0 * 1024.0), 0, 'f', 1)
+                                   .arg(static_cast<double>(totalBytes) / (1024.0 * 1024.0), 0, 'f', 1));
+}
+
 void DXFImportDialog::setStock(const StockMaterial& stock) {
     geometryView->plotStock(stock);
     if (stockStartSpinBox) stockStartSpinBox->setValue(stock.startPosition);
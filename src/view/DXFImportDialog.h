@@ -16,10 +16,16 @@
 #include <QFormLayout>
 #include <QSplitter>
 #include <QDialogButtonBox>
+#include <QProgressBar>
+#include <QListWidget>
+#include <QStringList>
+#include <vector>
 
 #include "GeometryView.h"
 #include "../model/MachineConfig.h"
 #include "../model/geometry/Geometry.h"
+#include "../utils/DXFStreamReader.h"
+#include "Simplify.h"
 
 enum ImportStage {
     GEOMETRY_SETUP,
@@ -48,12 +54,22 @@ private:
     QDoubleSpinBox* axialOffsetSpinBox;
     QDoubleSpinBox* radialOffsetSpinBox;
     QComboBox* unitsCombo;
+    QListWidget* layerList;
+    QLabel* importSummaryLabel;
+    QDoubleSpinBox* simplifyToleranceSpinBox;
+    QPushButton* simplifyButton;
+    QLabel* simplifySummaryLabel;
 
     // Stock setup controls
     QDoubleSpinBox* stockStartSpinBox;
     QDoubleSpinBox* stockEndSpinBox;
     QDoubleSpinBox* stockRadiusSpinBox;
 
+    // Background import progress
+    QWidget* importWidget;
+    QProgressBar* importProgressBar;
+    QLabel* importStatusLabel;
+
     // Dialog buttons
     QPushButton* okButton;
     QPushButton* cancelButton;
@@ -82,7 +98,22 @@ public:
     // Stage control
     void switchToStage(ImportStage stage);
 
+    // Lists the layers of the file with their sizes, checked if kept
+    void setLayers(const std::vector<DXFLayerStatistics>& layers, const std::vector<std::string>& keptLayers);
+
+    // Describes what the import cleanup changed
+    void setImportSummary(const QString& summary);
+
+    // Describes the reduction of the last simplification
+    void setSimplifySummary(const QString& summary);
+    double getSimplifyTolerance() const;
+
+    // Shows the progress bar and holds the dialog in the geometry stage while a file loads
+    void setImportRunning(bool running);
+
 public slots:
+    void setImportProgress(qint64 bytesRead, qint64 totalBytes, qint64 entities);
+
     void deactivateCenterLineSelection();
     void deactivateZeroPointSelection();
 
@@ -103,6 +134,8 @@ signals:
     void onAxialOffsetChanged(double offset);
     void onRadialOffsetChanged(double offset);
     void onUnitsChanged(const QString& units);
+    void layerSelectionChanged(const QStringList& keptLayers);
+    void simplifyRequested(double tolerance);
 
     void onStockStartOffsetChanged(double offset);
     void onStockEndOffsetChanged(double offset);
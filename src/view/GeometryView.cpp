@@ -18,10 +18,8 @@
 #include <qwt_scale_draw.h>
 
 #include "DXFImportDialog.h"
-#include "Line.h"
-#include "Vector.h"
 #include "../model/geometry/Geometry.h"
-#include "../model/geometry/Segment.h"
+#include "../model/geometry/SegmentStore.h"
 
 
 
@@ -96,22 +94,32 @@ void GeometryView::setupGrid() {
 
 void GeometryView::setGeometry(const Geometry &geom) {
     geometry = geom;
+    segmentTree = SegmentBVH(geometry.segments);
     spdlog::info("Geometry loaded with {} segments", geom.segments.size());
 
     segmentPlots.clear();
     pointPlots.clear();
 
-    for (size_t i = 0; i < geom.segments.size(); i++) {
-        if (auto line = dynamic_cast<Line*>(geom.segments[i].get())) {
-            double xs[] = {line->p1.x, line->p2.x};
-            double ys[] = {line->p1.y, line->p2.y};
-            std::shared_ptr<QwtPlotCurve> curve = std::make_shared<QwtPlotCurve>("Geometry");
+    const SegmentStore& segments = geom.segments;
+    for (size_t i = 0; i < segments.size(); i++) {
+        std::shared_ptr<QwtPlotCurve> curve = std::make_shared<QwtPlotCurve>("Geometry");
+        if (const auto arc = segments[i].asArc()) {
+            QVector<double> xs;
+            QVector<double> ys;
+            for (const Point& p : arc->tessellate(ARC_TESSELLATION_TOLERANCE)) {
+                xs.push_back(p.x);
+                ys.push_back(p.y);
+            }
+            curve->setSamples(xs, ys);
+        } else {
+            double xs[] = {segments.x1[i], segments.x2[i]};
+            double ys[] = {segments.y1[i], segments.y2[i]};
             curve->setSamples(xs, ys, 2);
-            curve->setRenderHint(QwtPlotItem::RenderAntialiased);
-            curve->setPen(normalPen);
-            curve->attach(this);
-            segmentPlots.push_back(curve);
         }
+        curve->setRenderHint(QwtPlotItem::RenderAntialiased);
+        curve->setPen(normalPen);
+        curve->attach(this);
+        segmentPlots.push_back(curve);
     }
 
     replot();
@@ -136,16 +144,8 @@ void GeometryView::enablePointPicking() {
     pointPlots.clear();
     points.clear();
 
-    for (size_t i = 0; i < geometry.segments.size(); i++) {
-        if (auto line = dynamic_cast<Line*>(geometry.segments[i].get())) {
-            if (std::find(points.begin(), points.end(), line->p1) == points.end()) {
-                points.push_back(line->p1);
-            }
-            if (std::find(points.begin(), points.end(), line->p2) == points.end()) {
-                points.push_back(line->p2);
-            }
-        }
-    }
+    points = weldEndpoints(geometry.segments, POINT_WELD_TOLERANCE).points;
+    pointGrid = PointGrid(points);
 
     spdlog::debug("Picking from: {} points", points.size());
 
@@ -166,6 +166,7 @@ void GeometryView::enablePointPicking() {
 void GeometryView::disablePointPicking() {
     pointPlots.clear();
     points.clear();
+    pointGrid = PointGrid();
     pointPicking = false;
     replot();
 }
@@ -188,28 +189,16 @@ long long GeometryView::getSegmentAtPoint(const QPointF& point) const {
     const QwtScaleMap xMap = canvasMap(xBottom);
     const double ppu = xMap.pDist() / xMap.sDist();
 
-    for (size_t i = 0; i < geometry.segments.size(); ++i) {
-        const double distance = geometry.segments[i]->distance(Point(point.x(), point.y()));
-        const double distancePx = distance * ppu;
-        if (distancePx <= HOVER_TOLERANCE_PX) {
-            return static_cast<long long>(i);
-        }
-    }
-    return -1;
+    const std::optional<size_t> nearest = segmentTree.nearest(Point(point.x(), point.y()), HOVER_TOLERANCE_PX / ppu);
+    return nearest ? static_cast<long long>(*nearest) : -1;
 }
 
 long long GeometryView::getPointAtPoint(const QPointF& point) const {
     const QwtScaleMap xMap = canvasMap(xBottom);
     const double ppu = xMap.pDist() / xMap.sDist();
 
-    for (size_t i = 0; i < points.size(); ++i) {
-        const double distance = Vector({point.x(), point.y()}, points[i]).norm();
-        const double distancePx = distance * ppu;
-        if (distancePx <= HOVER_TOLERANCE_PX) {
-            return static_cast<long long>(i);
-        }
-    }
-    return -1;
+    const std::optional<size_t> nearest = pointGrid.nearest(Point(point.x(), point.y()), HOVER_TOLERANCE_PX / ppu);
+    return nearest ? static_cast<long long>(*nearest) : -1;
 }
 
 void GeometryView::onHovered(const QPointF& point) {
@@ -21,10 +21,14 @@
 #include <qwt_plot_shapeitem.h>
 
 #include "../model/geometry/Geometry.h"
+#include "../model/geometry/PointGrid.h"
+#include "../model/geometry/SegmentBVH.h"
 #include "../model/MachineConfig.h"
 #include "../model/StockMaterial.h"
 
 #define HOVER_TOLERANCE_PX 5.0
+#define POINT_WELD_TOLERANCE 1e-6
+#define ARC_TESSELLATION_TOLERANCE 0.01
 
 #define STOCK_COLOR QColor(110, 45, 0, 80)
 
@@ -53,11 +57,13 @@ private:
     const MachineConfig& machineConfig;
 
     Geometry geometry;
+    SegmentBVH segmentTree;
     std::vector<std::shared_ptr<QwtPlotCurve>> segmentPlots;
     std::vector<size_t> selectedSegments;
 
     std::vector<std::shared_ptr<QwtPlotCurve>> pointPlots;
     std::vector<Point> points;
+    PointGrid pointGrid;
 
     long long hoveredSegmentIndex = -1;
     QPen hoverPenCopy = normalPen;
@@ -74,6 +74,19 @@ void LeftPanel::addOperationItem(const OperationConfiguration& op) {
     operationsItem->appendRow(item);
 }
 
+void LeftPanel::setOperationCycleTime(int index, const QString& cycleTime) {
+    QStandardItem* item = operationsItem->child(index);
+    if (!item || index >= static_cast<int>(project.operations.size())) {
+        return;
+    }
+
+    QString text(toString(project.operations[index].operationType).c_str());
+    if (!cycleTime.isEmpty()) {
+        text += "  " + cycleTime;
+    }
+    item->setText(text);
+}
+
 QTreeView* LeftPanel::getTreeView() const {
     return treeView;
 }
@@ -33,6 +33,8 @@ public:
     QStandardItemModel* getModel() const;
 
     void setProject(const Project& p);
+    // Appended to the operation's name, an empty text shows the name alone
+    void setOperationCycleTime(int index, const QString& cycleTime);
 
 signals:
     void operationDeleteRequested(int index);
@@ -22,6 +22,7 @@ void MachineConfigDialog::setupUI() {
     setupAxisDirectionGroup();
     setupMachineLimitsGroup();
     setupFeedRateSettingsGroup();
+    setupKinematicsGroup();
     setupDisplaySettingsGroup();
     setupPostProcessorGroup();
 
@@ -35,6 +36,7 @@ void MachineConfigDialog::setupUI() {
     mainLayout->addWidget(axisDirectionGroup);
     mainLayout->addWidget(machineLimitsGroup);
     mainLayout->addWidget(feedRatesGroup);
+    mainLayout->addWidget(kinematicsGroup);
     mainLayout->addWidget(displaySettingsGroup);
     mainLayout->addWidget(postProcessorGroup);
     mainLayout->addWidget(restoreDefaultsButton);
@@ -145,6 +147,30 @@ void MachineConfigDialog::setupFeedRateSettingsGroup() {
     feedRatesLayout->addRow("Retract Feed Rate:", retractFeedRateSpinBox);
 }
 
+void MachineConfigDialog::setupKinematicsGroup() {
+    kinematicsGroup = new QGroupBox("Kinematics", this);
+    kinematicsLayout = new QFormLayout(kinematicsGroup);
+
+    axisAccelerationSpinBox = new QDoubleSpinBox(this);
+    axisAccelerationSpinBox->setRange(0.0, 100000.0);
+    axisAccelerationSpinBox->setSuffix(" mm/s²");
+    axisAccelerationSpinBox->setDecimals(1);
+
+    spindleAccelerationSpinBox = new QDoubleSpinBox(this);
+    spindleAccelerationSpinBox->setRange(0.0, 100000.0);
+    spindleAccelerationSpinBox->setSuffix(" RPM/s");
+    spindleAccelerationSpinBox->setDecimals(0);
+
+    toolChangeTimeSpinBox = new QDoubleSpinBox(this);
+    toolChangeTimeSpinBox->setRange(0.0, 600.0);
+    toolChangeTimeSpinBox->setSuffix(" s");
+    toolChangeTimeSpinBox->setDecimals(1);
+
+    kinematicsLayout->addRow("Axis Acceleration:", axisAccelerationSpinBox);
+    kinematicsLayout->addRow("Spindle Acceleration:", spindleAccelerationSpinBox);
+    kinematicsLayout->addRow("Tool Change Time:", toolChangeTimeSpinBox);
+}
+
 void MachineConfigDialog::setupDisplaySettingsGroup() {
     displaySettingsGroup = new QGroupBox("Display Settings", this);
     displaySettingsLayout = new QFormLayout(displaySettingsGroup);
@@ -218,6 +244,11 @@ void MachineConfigDialog::updateUIFromConfig(const MachineConfig& config) {
     // Feed rates
     rapidFeedRateSpinBox->setValue(config.rapidFeedRate);
     retractFeedRateSpinBox->setValue(config.retractFeedRate);
+
+    // Kinematics
+    axisAccelerationSpinBox->setValue(config.axisAcceleration);
+    spindleAccelerationSpinBox->setValue(config.spindleAcceleration);
+    toolChangeTimeSpinBox->setValue(config.toolChangeTime);
     
     // Display settings
     displayPrecisionSpinBox->setValue(config.displayPrecision);
@@ -247,6 +278,11 @@ MachineConfig MachineConfigDialog::getConfigFromUI() const {
     // Feed rates
     config.rapidFeedRate = rapidFeedRateSpinBox->value();
     config.retractFeedRate = retractFeedRateSpinBox->value();
+
+    // Kinematics
+    config.axisAcceleration = axisAccelerationSpinBox->value();
+    config.spindleAcceleration = spindleAccelerationSpinBox->value();
+    config.toolChangeTime = toolChangeTimeSpinBox->value();
     
     // Display settings
     config.displayPrecision = displayPrecisionSpinBox->value();
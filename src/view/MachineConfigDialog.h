@@ -43,6 +43,7 @@ private:
     void setupAxisDirectionGroup();
     void setupMachineLimitsGroup();
     void setupFeedRateSettingsGroup();
+    void setupKinematicsGroup();
     void setupDisplaySettingsGroup();
     void setupPostProcessorGroup();
     void connectSignals();
@@ -83,6 +84,14 @@ private:
 
     QDoubleSpinBox* rapidFeedRateSpinBox;
     QDoubleSpinBox* retractFeedRateSpinBox;
+
+    // Kinematics
+    QGroupBox* kinematicsGroup;
+    QFormLayout* kinematicsLayout;
+
+    QDoubleSpinBox* axisAccelerationSpinBox;
+    QDoubleSpinBox* spindleAccelerationSpinBox;
+    QDoubleSpinBox* toolChangeTimeSpinBox;
     
     // Display Settings
     QGroupBox* displaySettingsGroup;
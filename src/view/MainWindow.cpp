@@ -7,6 +7,7 @@
 #include <QAction>
 #include <QStyle>
 #include <QSplitter>
+#include <QStatusBar>
 
 MainWindow::MainWindow(const MachineConfig& config, const ToolTable& tools, QWidget *parent)
     : machineConfig(config), toolTable(tools), QMainWindow(parent), centralWidget(nullptr), mainLayout(nullptr), mainSplitter(nullptr), leftPanel(nullptr), currentLeftWidget(nullptr), rightContentArea(nullptr), ribbonBar(nullptr) {
@@ -45,6 +46,9 @@ void MainWindow::setupUI() {
     mainSplitter->setCollapsible(1, false);
     
     mainLayout->addWidget(mainSplitter, 1);
+
+    cycleTimeLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(cycleTimeLabel);
 }
 
 void MainWindow::createRibbonBar() {
@@ -106,6 +110,10 @@ LeftPanel& MainWindow::getLeftPanel() const {
     return *leftPanel;
 }
 
+void MainWindow::setCycleTime(const QString& text) {
+    cycleTimeLabel->setText(text);
+}
+
 void MainWindow::enableOperationButtons() {
     facingAction->setEnabled(true);
     turningAction->setEnabled(true);
@@ -38,6 +38,7 @@ private:
     QWidget* rightContentArea;
     QToolBar* ribbonBar;
     GeometryView* geometryView;
+    QLabel* cycleTimeLabel;
 
     OperationConfigurationView* operationConfigView;
 
@@ -68,6 +69,9 @@ public:
     void replaceLeftPanel(QWidget* newWidget);
     void restoreLeftPanel();
 
+    // Shown in the status bar
+    void setCycleTime(const QString& text);
+
 private:
     void setupUI();
     void createRibbonBar();
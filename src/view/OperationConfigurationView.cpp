@@ -170,12 +170,20 @@ void OperationConfigurationView::setupUI() {
     backoffDistanceInput->setValue(1.0);
     backoffDistanceInput->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
+    stockAllowanceInput = new QDoubleSpinBox();
+    stockAllowanceInput->setRange(0.0, 10.0);
+    stockAllowanceInput->setSuffix(" mm");
+    stockAllowanceInput->setDecimals(2);
+    stockAllowanceInput->setValue(0.0);
+    stockAllowanceInput->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+
     if (config.showStepover) passesLayout->addRow("Stepover:", stepoverInput);
     if (config.showCutDepthPerPass) passesLayout->addRow("Cut Depth per Pass:", cutDepthPerPassInput);
     if (config.showSpringPasses) passesLayout->addRow("Spring Passes:", springPassesInput);
     if (config.showPeckDepth) passesLayout->addRow("Peck Depth:", peckDepthInput);
     if (config.showDwellTime) passesLayout->addRow("Dwell Time:", dwellTimeInput);
     if (config.showBackoffDistance) passesLayout->addRow("Backoff Distance:", backoffDistanceInput);
+    if (config.showStockAllowance) passesLayout->addRow("Stock Allowance:", stockAllowanceInput);
 
     // Add tabs to the tab widget based on visibility configuration
     if (config.showToolTab) tabWidget->addTab(toolTab, "Tool");
@@ -259,6 +267,9 @@ void OperationConfigurationView::connectSignals() {
     connect(backoffDistanceInput, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
             this, &OperationConfigurationView::backoffDistanceChanged);
 
+    connect(stockAllowanceInput, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &OperationConfigurationView::stockAllowanceChanged);
+
     // Button connections
     connect(okButton, &QPushButton::clicked, this, &OperationConfigurationView::okPressed);
     connect(cancelButton, &QPushButton::clicked, this, &OperationConfigurationView::cancelPressed);
@@ -315,4 +326,5 @@ void OperationConfigurationView::setOperationConfiguration(const OperationConfig
     peckDepthInput->setValue(config.peckDepth);
     dwellTimeInput->setValue(config.dwellTime);
     backoffDistanceInput->setValue(config.backoffDistance);
+    stockAllowanceInput->setValue(config.stockAllowance);
 }
\ No newline at end of file
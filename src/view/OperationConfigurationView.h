@@ -43,6 +43,7 @@ class OperationConfigurationView : public QWidget {
     QDoubleSpinBox* peckDepthInput;
     QSpinBox* dwellTimeInput;
     QDoubleSpinBox* backoffDistanceInput;
+    QDoubleSpinBox* stockAllowanceInput;
 
     QPushButton* okButton;
     QPushButton* cancelButton;
@@ -84,6 +85,7 @@ class OperationConfigurationView : public QWidget {
         void peckDepthChanged(double depth);
         void dwellTimeChanged(int time);
         void backoffDistanceChanged(double distance);
+        void stockAllowanceChanged(double allowance);
 
         // Button signals
         void okPressed();
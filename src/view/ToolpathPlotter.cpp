@@ -5,22 +5,28 @@
 #include "ToolpathPlotter.h"
 #include <spdlog/spdlog.h>
 #include <qwt_text.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 ToolpathPlotter::ToolpathPlotter(GeometryView& geomView) : geometryView(geomView) {
     spdlog::debug("Creating ToolpathPlotter");
 }
 
 ToolpathPlotter::~ToolpathPlotter() {
+    clearPreview();
     clearToolpaths();
 }
 
-void ToolpathPlotter::plotToolpaths(const std::vector<TToolpathSequence>& sequences) {
+void ToolpathPlotter::plotToolpaths(const std::vector<TToolpathSequence>& sequences, std::optional<size_t> hiddenIndex) {
     spdlog::debug("Plotting {} toolpath sequences", sequences.size());
 
     clearToolpaths();
 
     for (size_t i = 0; i < sequences.size(); ++i) {
-        plotToolpathSequence(sequences[i], i);
+        if (i != hiddenIndex) {
+            plotToolpathSequence(sequences[i], i);
+        }
     }
 
     geometryView.replot();
@@ -29,25 +35,43 @@ void ToolpathPlotter::plotToolpaths(const std::vector<TToolpathSequence>& sequen
 void ToolpathPlotter::plotToolpathSequence(const TToolpathSequence& sequence, size_t sequenceIndex) {
     spdlog::debug("Plotting toolpath sequence {} with {} toolpaths", sequenceIndex, sequence.size());
 
-    for (size_t i = 0; i < sequence.toolpaths.size(); ++i) {
-        const auto& toolpath = sequence.toolpaths[i];
+    size_t i = 0;
+    for (const auto [move, state] : sequence) {
+        plotMove(move, state, sequenceIndex, i++);
+    }
+}
 
-        // Check toolpath type and plot accordingly
-        if (auto line = dynamic_cast<const TLine*>(toolpath.get())) {
-            plotLine(*line, sequenceIndex, i);
-        }
+void ToolpathPlotter::addToolpathSequence(const TToolpathSequence& sequence, size_t sequenceIndex) {
+    plotToolpathSequence(sequence, sequenceIndex);
+    geometryView.replot();
+}
+
+void ToolpathPlotter::plotMove(const TMove& move, const TMoveState& state, size_t sequenceIndex, size_t toolpathIndex) {
+    // A dwell has no extent to draw
+    if (move.kind == TMoveKind::Dwell) {
+        return;
+    }
+
+    QPen pen = getPenForToolpath(move);
+    QString title = getTitleForToolpath(move, state, sequenceIndex, toolpathIndex);
+
+    switch (move.type) {
+        case TToolpathType::Line:
+            plotToolpathLine(move, pen, title);
+            break;
+        case TToolpathType::Arc:
+            plotToolpathArc(move, pen, title);
+            break;
         // Add more toolpath types here as they are implemented
     }
 }
 
 void ToolpathPlotter::plotLine(const TLine& line, size_t sequenceIndex, size_t toolpathIndex) {
-    QPen pen = getPenForToolpath(line);
-    QString title = getTitleForToolpath(line, sequenceIndex, toolpathIndex);
-
-    plotToolpathLine(line, pen, title);
+    plotMove({line.start, line.end, {}, TToolpathType::Line, line.kind, false},
+             {line.toolNumber, line.feedRate, line.rpm}, sequenceIndex, toolpathIndex);
 }
 
-void ToolpathPlotter::plotToolpathLine(const TLine& line, const QPen& pen, const QString& title) {
+void ToolpathPlotter::plotToolpathLine(const TMove& line, const QPen& pen, const QString& title) {
     auto curve = std::make_unique<QwtPlotCurve>(title);
 
     // Set up the curve
@@ -64,27 +88,61 @@ void ToolpathPlotter::plotToolpathLine(const TLine& line, const QPen& pen, const
     toolpathCurves.push_back(std::move(curve));
 }
 
-QPen ToolpathPlotter::getPenForToolpath(const TToolpath& toolpath) {
-    // Determine pen style based on toolpath characteristics
-    // This is a simple heuristic - you can make it more sophisticated
+void ToolpathPlotter::plotArc(const TArc& arc, size_t sequenceIndex, size_t toolpathIndex) {
+    plotMove({arc.start, arc.end, arc.center, TToolpathType::Arc, arc.kind, arc.clockwise},
+             {arc.toolNumber, arc.feedRate, arc.rpm}, sequenceIndex, toolpathIndex);
+}
+
+void ToolpathPlotter::plotToolpathArc(const TMove& arc, const QPen& pen, const QString& title) {
+    auto curve = std::make_unique<QwtPlotCurve>(title);
+
+    curve->setPen(pen);
+    curve->setRenderHint(QwtPlotItem::RenderAntialiased, true);
+
+    // Angles in the plot plane, Z horizontal and X vertical
+    const double radius = std::hypot(arc.start.z - arc.center.z, arc.start.x - arc.center.x);
+    const double startAngle = std::atan2(arc.start.x - arc.center.x, arc.start.z - arc.center.z);
+    const double endAngle = std::atan2(arc.end.x - arc.center.x, arc.end.z - arc.center.z);
+    double sweep = endAngle - startAngle;
+    if (arc.clockwise && sweep >= 0.0) {
+        sweep -= 2.0 * M_PI;
+    } else if (!arc.clockwise && sweep <= 0.0) {
+        sweep += 2.0 * M_PI;
+    }
 
-    if (toolpath.feedRate > 1000) {
-        // High feed rate suggests rapid move
-        return rapidMovePen;
-    } else if (toolpath.feedRate < 50) {
-        // Very low feed rate suggests plunge move
-        return plungeMovePen;
-    } else {
-        // Normal feed rate
-        return feedMovePen;
+    const int steps = std::max(2, static_cast<int>(std::ceil(std::abs(sweep) / ARC_PLOT_STEP)));
+    QVector<double> xData;
+    QVector<double> yData;
+    for (int i = 0; i <= steps; i++) {
+        const double angle = startAngle + sweep * i / steps;
+        xData.push_back(arc.center.z + radius * std::cos(angle));
+        yData.push_back(arc.center.x + radius * std::sin(angle));
+    }
+
+    curve->setSamples(xData, yData);
+    curve->attach(&geometryView);
+
+    toolpathCurves.push_back(std::move(curve));
+}
+
+QPen ToolpathPlotter::getPenForToolpath(const TMove& move) {
+    switch (move.kind) {
+        case TMoveKind::Rapid:
+            return rapidMovePen;
+        case TMoveKind::Plunge:
+            return plungeMovePen;
+        case TMoveKind::Retract:
+            return retractMovePen;
+        default:
+            return feedMovePen;
     }
 }
 
-QString ToolpathPlotter::getTitleForToolpath(const TToolpath& toolpath, size_t sequenceIndex, size_t toolpathIndex) {
+QString ToolpathPlotter::getTitleForToolpath(const TMove& move, const TMoveState& state, size_t sequenceIndex, size_t toolpathIndex) {
     return QString("Seq%1_T%2_%3_%4")
            .arg(sequenceIndex)
-           .arg(toolpath.toolNumber)
-           .arg(toString(TToolpathType::Line).c_str())
+           .arg(state.toolNumber)
+           .arg(toString(move.kind).c_str())
            .arg(toolpathIndex);
 }
 
@@ -99,6 +157,33 @@ void ToolpathPlotter::clearToolpaths() {
     geometryView.replot();
 }
 
+void ToolpathPlotter::plotPreview(const TToolpathSequence& sequence) {
+    for (auto& curve : previewCurves) {
+        curve->detach();
+    }
+    previewCurves.clear();
+
+    // Plotted like any other sequence, then moved out of the toolpath curves
+    const size_t first = toolpathCurves.size();
+    plotToolpathSequence(sequence, 0);
+    std::move(toolpathCurves.begin() + first, toolpathCurves.end(), std::back_inserter(previewCurves));
+    toolpathCurves.resize(first);
+
+    geometryView.replot();
+}
+
+void ToolpathPlotter::clearPreview() {
+    if (previewCurves.empty()) {
+        return;
+    }
+    for (auto& curve : previewCurves) {
+        curve->detach();
+    }
+    previewCurves.clear();
+
+    geometryView.replot();
+}
+
 void ToolpathPlotter::showToolpaths() {
     spdlog::debug("Showing toolpath curves");
 
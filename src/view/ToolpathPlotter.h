@@ -7,18 +7,24 @@
 
 #include <vector>
 #include <memory>
+#include <optional>
 #include <QPen>
 #include <qwt_plot_curve.h>
 
 #include "GeometryView.h"
 #include "../model/toolpath/Toolpath.h"
 
+// Angular resolution used to draw arc moves, in radians
+#define ARC_PLOT_STEP (M_PI / 90.0)
+
 class ToolpathPlotter {
 private:
     GeometryView& geometryView;
 
     // Store curves for different toolpath sequences
     std::vector<std::unique_ptr<QwtPlotCurve>> toolpathCurves;
+    // Toolpath of the operation being edited, replaced on every preview update
+    std::vector<std::unique_ptr<QwtPlotCurve>> previewCurves;
 
     // Pen styles following CAM industry conventions
     const QPen rapidMovePen = QPen(QColor(255, 165, 0), 0.5, Qt::DashLine);      // Orange - rapid moves
@@ -27,23 +33,31 @@ private:
     const QPen retractMovePen = QPen(QColor(255, 255, 0), 0.5, Qt::DotLine);     // Yellow - retract moves
 
     // Helper methods
-    void plotToolpathLine(const TLine& line, const QPen& pen, const QString& title);
-    QPen getPenForToolpath(const TToolpath& toolpath);
-    QString getTitleForToolpath(const TToolpath& toolpath, size_t sequenceIndex, size_t toolpathIndex);
+    void plotToolpathLine(const TMove& line, const QPen& pen, const QString& title);
+    void plotToolpathArc(const TMove& arc, const QPen& pen, const QString& title);
+    QPen getPenForToolpath(const TMove& move);
+    QString getTitleForToolpath(const TMove& move, const TMoveState& state, size_t sequenceIndex, size_t toolpathIndex);
 
 public:
     explicit ToolpathPlotter(GeometryView& geomView);
     ~ToolpathPlotter();
 
     // Main plotting methods
-    void plotToolpaths(const std::vector<TToolpathSequence>& sequences);
+    // hiddenIndex leaves out a sequence, such as the one of an operation being previewed
+    void plotToolpaths(const std::vector<TToolpathSequence>& sequences, std::optional<size_t> hiddenIndex = std::nullopt);
     void plotToolpathSequence(const TToolpathSequence& sequence, size_t sequenceIndex = 0);
+    // Plots one more sequence on top of the existing ones and replots
+    void addToolpathSequence(const TToolpathSequence& sequence, size_t sequenceIndex);
     void clearToolpaths();
+    void plotPreview(const TToolpathSequence& sequence);
+    void clearPreview();
     void showToolpaths();
     void hideToolpaths();
 
     // Individual toolpath plotting
+    void plotMove(const TMove& move, const TMoveState& state, size_t sequenceIndex = 0, size_t toolpathIndex = 0);
     void plotLine(const TLine& line, size_t sequenceIndex = 0, size_t toolpathIndex = 0);
+    void plotArc(const TArc& arc, size_t sequenceIndex = 0, size_t toolpathIndex = 0);
 };
 
 #endif //TURNLAB_TOOLPATHPLOTTER_H
\ No newline at end of file
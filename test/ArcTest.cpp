@@ -0,0 +1,103 @@
+//
+// Unit tests for Arc class
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "Arc.h"
+#include "Geometry.h"
+#include "SegmentStore.h"
+
+class ArcTest : public ::testing::Test {
+protected:
+    // Quarter circle around the origin from (1, 0) to (0, 1), counter-clockwise
+    Arc quarter = Arc::fromCenter(Point(0.0, 0.0), 1.0, 0.0, M_PI_2);
+};
+
+// Test center, radius and sweep derived from the bulge
+TEST_F(ArcTest, Parameters) {
+    EXPECT_NEAR(quarter.bulge, std::tan(M_PI / 8.0), 1e-12);
+    EXPECT_NEAR(quarter.center().x, 0.0, 1e-12);
+    EXPECT_NEAR(quarter.center().y, 0.0, 1e-12);
+    EXPECT_NEAR(quarter.radius(), 1.0, 1e-12);
+    EXPECT_NEAR(quarter.sweep(), M_PI_2, 1e-12);
+    EXPECT_FALSE(quarter.isClockwise());
+
+    const Arc clockwise(Point(0.0, 1.0), Point(1.0, 0.0), -quarter.bulge);
+    EXPECT_TRUE(clockwise.isClockwise());
+    EXPECT_NEAR(clockwise.center().x, 0.0, 1e-12);
+    EXPECT_NEAR(clockwise.center().y, 0.0, 1e-12);
+}
+
+// Test distance inside and outside the swept range
+TEST_F(ArcTest, Distance) {
+    EXPECT_NEAR(quarter.distance(Point(2.0, 2.0)), 2.0 * std::sqrt(2.0) - 1.0, 1e-12);
+    EXPECT_NEAR(quarter.distance(Point(0.0, 0.0)), 1.0, 1e-12);
+    // Outside the sweep the closest point is an endpoint
+    EXPECT_NEAR(quarter.distance(Point(-1.0, -1.0)), std::sqrt(5.0), 1e-12);
+}
+
+// Test bounds include the axis extremes the arc passes through
+TEST_F(ArcTest, Bounds) {
+    const Arc half(Point(0.0, 1.0), Point(0.0, -1.0), 1.0);
+    const BoundingBox box = half.bounds();
+    EXPECT_NEAR(box.minX, -1.0, 1e-12);
+    EXPECT_NEAR(box.maxX, 0.0, 1e-12);
+    EXPECT_NEAR(box.minY, -1.0, 1e-12);
+    EXPECT_NEAR(box.maxY, 1.0, 1e-12);
+
+    EXPECT_TRUE(arcIntersects(0.0, 1.0, 0.0, -1.0, 1.0, BoundingBox(-1.5, -0.1, -0.5, 0.1)));
+    EXPECT_FALSE(arcIntersects(0.0, 1.0, 0.0, -1.0, 1.0, BoundingBox(-0.5, -0.1, -0.2, 0.1)));
+}
+
+// Test tessellation respects the chord tolerance
+TEST_F(ArcTest, Tessellate) {
+    const std::vector<Point> points = quarter.tessellate(0.001);
+    ASSERT_GE(points.size(), 3);
+    EXPECT_EQ(points.front(), quarter.p1);
+    EXPECT_EQ(points.back(), quarter.p2);
+    for (size_t i = 1; i < points.size(); i++) {
+        const Point mid((points[i - 1].x + points[i].x) / 2.0, (points[i - 1].y + points[i].y) / 2.0);
+        EXPECT_LE(quarter.distance(mid), 0.001 + 1e-12);
+    }
+}
+
+// Test mirroring flips the turning direction
+TEST_F(ArcTest, TransformMirror) {
+    const auto mirrored = quarter.transform({Transform::mirrorX()});
+    const auto* arc = dynamic_cast<const Arc*>(mirrored.get());
+    ASSERT_NE(arc, nullptr);
+    EXPECT_TRUE(arc->isClockwise());
+    EXPECT_NEAR(arc->distance(Point(-std::sqrt(0.5), std::sqrt(0.5))), 0.0, 1e-12);
+
+    SegmentStore store;
+    store.addArc(quarter);
+    const Geometry transformed = Geometry(store).transform(Transform::mirrorX());
+    EXPECT_NEAR(transformed.segments.bulge[0], -quarter.bulge, 1e-12);
+    EXPECT_NEAR(transformed.segments.distance(0, Point(-std::sqrt(0.5), std::sqrt(0.5))), 0.0, 1e-12);
+}
+
+// Test equality with reversed direction
+TEST_F(ArcTest, Equality) {
+    const Arc reversed(quarter.p2, quarter.p1, -quarter.bulge);
+    EXPECT_TRUE(quarter == reversed);
+    EXPECT_TRUE(quarter != Arc(quarter.p1, quarter.p2, -quarter.bulge));
+}
+
+// Test JSON round trip through Geometry
+TEST_F(ArcTest, GeometryJson) {
+    SegmentStore store;
+    store.addLine(1.0, 0.0, 2.0, 0.0);
+    store.addArc(quarter);
+    const nlohmann::json j = Geometry(store);
+    EXPECT_EQ(j[1]["type"], "Arc");
+
+    const Geometry loaded = j.get<Geometry>();
+    ASSERT_EQ(loaded.segments.size(), 2);
+    const auto arc = loaded.segments[1].asArc();
+    ASSERT_TRUE(arc.has_value());
+    EXPECT_TRUE(*arc == quarter);
+    EXPECT_FALSE(loaded.segments[0].asArc().has_value());
+}
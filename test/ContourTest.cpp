@@ -0,0 +1,217 @@
+//
+// Unit tests for contours and the contouring generator
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "toolpath/Contour.h"
+#include "toolpath/ToolpathGenerator.h"
+
+namespace {
+// Quarter circle, tan(90° / 4)
+constexpr double QUARTER_BULGE = 0.41421356237309503;
+
+// Shoulder at z -20 stepping up from radius 10 to 15, running towards the chuck
+SegmentStore steppedProfile() {
+    SegmentStore segments;
+    segments.addLine(0.0, 10.0, -20.0, 10.0);
+    segments.addLine(-20.0, 10.0, -20.0, 15.0);
+    segments.addLine(-20.0, 15.0, -40.0, 15.0);
+    return segments;
+}
+
+void expectPoint(const TPoint& point, const double x, const double z) {
+    EXPECT_NEAR(point.x, x, 1e-9);
+    EXPECT_NEAR(point.z, z, 1e-9);
+}
+
+double cross(const TPoint& o, const TPoint& a, const TPoint& b) {
+    return (a.z - o.z) * (b.x - o.x) - (a.x - o.x) * (b.z - o.z);
+}
+
+// Whether the segments meet, touching included
+bool intersects(const TPoint& a, const TPoint& b, const TPoint& c, const TPoint& d) {
+    const double d1 = cross(c, d, a);
+    const double d2 = cross(c, d, b);
+    const double d3 = cross(a, b, c);
+    const double d4 = cross(a, b, d);
+    if (((d1 > 0.0 && d2 < 0.0) || (d1 < 0.0 && d2 > 0.0)) && ((d3 > 0.0 && d4 < 0.0) || (d3 < 0.0 && d4 > 0.0))) {
+        return true;
+    }
+    const auto onSegment = [](const TPoint& p, const TPoint& q, const TPoint& r) {
+        return std::abs(cross(p, q, r)) < 1e-12 && std::min(p.x, q.x) <= r.x && r.x <= std::max(p.x, q.x) &&
+               std::min(p.z, q.z) <= r.z && r.z <= std::max(p.z, q.z);
+    };
+    return onSegment(c, d, a) || onSegment(c, d, b) || onSegment(a, b, c) || onSegment(a, b, d);
+}
+}
+
+// Test that segments are chained in selection order and turned to connect
+TEST(ContourTest, BuildContour) {
+    SegmentStore segments;
+    segments.addLine(0.0, 10.0, -10.0, 10.0);
+    segments.addArc(-10.0, 10.0, -15.0, 15.0, QUARTER_BULGE);
+    segments.addLine(-15.0, 15.0, -30.0, 15.0);
+    // The same arc stored the other way round
+    segments.addArc(-15.0, 15.0, -10.0, 10.0, -QUARTER_BULGE);
+    // First segment stored pointing away from the rest of the chain
+    segments.addLine(-10.0, 10.0, 0.0, 10.0);
+
+    const Contour contour = buildContour(segments, {0, 1, 2});
+    ASSERT_EQ(contour.size(), 3);
+    expectPoint(contour[0].start, 10.0, 0.0);
+    expectPoint(contour[1].start, 10.0, -10.0);
+    expectPoint(contour[1].end, 15.0, -15.0);
+    expectPoint(contour[2].end, 15.0, -30.0);
+    EXPECT_FALSE(contour[0].arc);
+    EXPECT_TRUE(contour[1].arc);
+
+    const Contour reversed = buildContour(segments, {4, 3, 2});
+    ASSERT_EQ(reversed.size(), 3);
+    expectPoint(reversed[0].start, 10.0, 0.0);
+    expectPoint(reversed[1].start, 10.0, -10.0);
+    expectPoint(reversed[1].center, contour[1].center.x, contour[1].center.z);
+    EXPECT_EQ(reversed[1].clockwise, contour[1].clockwise);
+    expectPoint(reversed[2].end, 15.0, -30.0);
+}
+
+// Test that selections which do not form a chain are rejected
+TEST(ContourTest, BuildContourRejectsInvalidSelections) {
+    const SegmentStore segments = steppedProfile();
+    EXPECT_THROW(buildContour(segments, {}), std::invalid_argument);
+    EXPECT_THROW(buildContour(segments, {0, 7}), std::invalid_argument);
+    EXPECT_THROW(buildContour(segments, {0, 2}), std::invalid_argument);
+    EXPECT_NO_THROW(buildContour(segments, {0, 1}));
+}
+
+// Test that contours are turned to run from the tailstock end towards the chuck
+TEST(ContourTest, OrientTowardsChuck) {
+    const SegmentStore segments = steppedProfile();
+
+    Contour contour = buildContour(segments, {2, 1, 0});
+    expectPoint(contour.front().start, 15.0, -40.0);
+    orientTowardsChuck(contour, AxisDirection::Positive);
+    expectPoint(contour.front().start, 10.0, 0.0);
+    expectPoint(contour.back().end, 15.0, -40.0);
+
+    orientTowardsChuck(contour, AxisDirection::Negative);
+    expectPoint(contour.front().start, 15.0, -40.0);
+}
+
+// Test that offsetting rounds convex corners and trims concave ones
+TEST(ContourTest, OffsetContour) {
+    const Contour contour = buildContour(steppedProfile(), {0, 1, 2});
+    const Contour offset = offsetContour(contour, 1.0);
+
+    ASSERT_EQ(offset.size(), 4);
+    // Inside corner at the foot of the shoulder
+    expectPoint(offset[0].start, 11.0, 0.0);
+    expectPoint(offset[0].end, 11.0, -19.0);
+    expectPoint(offset[1].start, 11.0, -19.0);
+    expectPoint(offset[1].end, 15.0, -19.0);
+    // Outside corner at the top of the shoulder
+    EXPECT_TRUE(offset[2].arc);
+    EXPECT_FALSE(offset[2].clockwise);
+    expectPoint(offset[2].center, 15.0, -20.0);
+    expectPoint(offset[2].start, 15.0, -19.0);
+    expectPoint(offset[2].end, 16.0, -20.0);
+    expectPoint(offset[3].start, 16.0, -20.0);
+    expectPoint(offset[3].end, 16.0, -40.0);
+
+    EXPECT_EQ(offsetContour(contour, 0.0).size(), contour.size());
+}
+
+// Test that the contouring toolpath leads in, follows the profile once per pass and leads out
+TEST(ContourTest, GenerateContouringToolpath) {
+    const SegmentStore segments = steppedProfile();
+    OperationConfiguration operation;
+    operation.operationType = OperationType::Contouring;
+    operation.geometrySelection = {0, 1, 2};
+    operation.feedDistance = 1.0;
+    operation.springPasses = 1;
+    operation.stockAllowance = 0.5;
+
+    const TToolpathSequence toolpath = ToolpathGenerator::generateToolpath(operation, MachineConfig(), segments);
+    std::vector<TMove> feeds;
+    size_t leadIns = 0;
+    for (const TMove& move : toolpath.moves()) {
+        if (move.kind == TMoveKind::Feed) {
+            feeds.push_back(move);
+        } else if (move.kind == TMoveKind::Plunge) {
+            leadIns++;
+            expectPoint(move.end, 10.5, 0.0);
+            // Back along the profile and out of the stock
+            expectPoint(move.start, 11.5, 1.0);
+        }
+    }
+    // Three profile elements and the rounded corner, twice
+    ASSERT_EQ(feeds.size(), 8);
+    EXPECT_EQ(leadIns, 2);
+    expectPoint(feeds.front().start, 10.5, 0.0);
+    expectPoint(feeds.back().end, 15.5, -40.0);
+    EXPECT_EQ(feeds[2].type, TToolpathType::Arc);
+
+    // Nothing to follow without a valid selection
+    operation.geometrySelection = {0, 2};
+    EXPECT_TRUE(ToolpathGenerator::generateToolpath(operation, MachineConfig(), segments).empty());
+}
+
+// Test that profiles with thousands of segments are followed in one pass
+TEST(ContourTest, GenerateLongContour) {
+    constexpr size_t segmentCount = 5000;
+    SegmentStore segments;
+    OperationConfiguration operation;
+    operation.operationType = OperationType::Contouring;
+    operation.springPasses = 0;
+    for (size_t i = 0; i < segmentCount; i++) {
+        // Small ripple along the part
+        const double z = -0.01 * static_cast<double>(i);
+        segments.addLine(z, i % 2 ? 10.0 : 10.005, z - 0.01, i % 2 ? 10.005 : 10.0);
+        operation.geometrySelection.push_back(i);
+    }
+
+    const TToolpathSequence toolpath = ToolpathGenerator::generateToolpath(operation, MachineConfig(), segments);
+    size_t feeds = 0;
+    for (const TMove& move : toolpath.moves()) {
+        feeds += move.kind == TMoveKind::Feed;
+    }
+    EXPECT_EQ(feeds, segmentCount);
+}
+
+// Test that a profile starting with a face is approached from the air side without rapids through it
+TEST(ContourTest, ContouringApproachesFaceFromAirSide) {
+    SegmentStore segments;
+    // Face at z 0 from the centerline out to radius 10, then the outer diameter towards the chuck
+    segments.addLine(0.0, 0.0, 0.0, 10.0);
+    segments.addLine(0.0, 10.0, -20.0, 10.0);
+    OperationConfiguration operation;
+    operation.operationType = OperationType::Contouring;
+    operation.geometrySelection = {0, 1};
+    operation.feedDistance = 1.0;
+    operation.springPasses = 1;
+
+    const Contour contour = buildContour(segments, operation.geometrySelection);
+    const TToolpathSequence toolpath = ToolpathGenerator::generateToolpath(operation, MachineConfig(), segments);
+    ASSERT_FALSE(toolpath.empty());
+
+    size_t leadIns = 0;
+    for (const TMove& move : toolpath.moves()) {
+        EXPECT_GE(move.start.x, 0.0);
+        EXPECT_GE(move.end.x, 0.0);
+        if (move.kind == TMoveKind::Rapid) {
+            for (const auto& element : contour) {
+                EXPECT_FALSE(intersects(move.start, move.end, element.start, element.end));
+            }
+        } else if (move.kind == TMoveKind::Plunge) {
+            leadIns++;
+            // In front of the face, on the centerline
+            expectPoint(move.start, 0.0, 1.0);
+            expectPoint(move.end, 0.0, 0.0);
+        }
+    }
+    EXPECT_EQ(leadIns, 2);
+}
@@ -0,0 +1,100 @@
+//
+// Unit tests for the cycle time estimator
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "toolpath/CycleTimeEstimator.h"
+
+class CycleTimeEstimatorTest : public ::testing::Test {
+protected:
+    MachineConfig machineConfig;
+
+    void SetUp() override {
+        // 10 mm/s feeds, reached after 0.5 mm
+        machineConfig.axisAcceleration = 100.0;
+        machineConfig.rapidFeedRate = 600.0;
+        machineConfig.maxFeedRateMMMin = 2000.0;
+        machineConfig.spindleAcceleration = 1000.0;
+        machineConfig.toolChangeTime = 5.0;
+    }
+};
+
+// Test a single move with a trapezoidal profile, tool change and spindle start
+TEST_F(CycleTimeEstimatorTest, SingleMove) {
+    TToolpathSequence sequence;
+    sequence.addLine(TPoint(10.0, 0.0), TPoint(10.0, -100.0), 1, 600.0, 1000.0);
+
+    const CycleTimeEstimate estimate = CycleTimeEstimator(machineConfig).estimate(sequence);
+    EXPECT_NEAR(estimate.cuttingTime, 0.1 + 9.9 + 0.1, 1e-9);
+    EXPECT_DOUBLE_EQ(estimate.positioningTime, 0.0);
+    EXPECT_EQ(estimate.toolChanges, 1);
+    EXPECT_DOUBLE_EQ(estimate.toolChangeTime, 5.0);
+    EXPECT_DOUBLE_EQ(estimate.spindleTime, 1.0);
+    EXPECT_NEAR(estimate.total(), 16.1, 1e-9);
+}
+
+// Test a move too short to reach its feed rate
+TEST_F(CycleTimeEstimatorTest, TriangularProfile) {
+    TToolpathSequence sequence;
+    sequence.addLine(TPoint(10.0, 0.0), TPoint(10.0, -0.5), 1, 600.0, 1000.0);
+
+    const CycleTimeEstimate estimate = CycleTimeEstimator(machineConfig).estimate(sequence);
+    EXPECT_NEAR(estimate.cuttingTime, 2.0 * std::sqrt(50.0) / 100.0, 1e-9);
+}
+
+// Test that speed carries through straight junctions but not through corners
+TEST_F(CycleTimeEstimatorTest, Junctions) {
+    TToolpathSequence straight;
+    straight.addLine(TPoint(10.0, 0.0), TPoint(10.0, -50.0), 1, 600.0, 1000.0);
+    straight.addLine(TPoint(10.0, -50.0), TPoint(10.0, -100.0), 1, 600.0, 1000.0);
+
+    TToolpathSequence corner;
+    corner.addLine(TPoint(10.0, 0.0), TPoint(10.0, -50.0), 1, 600.0, 1000.0);
+    corner.addLine(TPoint(10.0, -50.0), TPoint(60.0, -50.0), 1, 600.0, 1000.0);
+
+    CycleTimeEstimator estimator(machineConfig);
+    EXPECT_NEAR(estimator.estimate(straight).cuttingTime, 10.1, 1e-9);
+    EXPECT_NEAR(estimator.estimate(corner).cuttingTime, 10.2, 1e-9);
+}
+
+// Test that rapids use the machine rapid rate and feeds are capped at the machine maximum
+TEST_F(CycleTimeEstimatorTest, FeedRates) {
+    machineConfig.axisAcceleration = 0.0;
+    TToolpathSequence sequence;
+    sequence.addRapid(TPoint(10.0, 0.0), TPoint(10.0, -100.0), 1, 5000.0, 1000.0);
+    sequence.addLine(TPoint(10.0, -100.0), TPoint(10.0, -200.0), 1, 6000.0, 1000.0);
+
+    const CycleTimeEstimate estimate = CycleTimeEstimator(machineConfig).estimate(sequence);
+    EXPECT_DOUBLE_EQ(estimate.positioningTime, 10.0);
+    EXPECT_DOUBLE_EQ(estimate.cuttingTime, 3.0);
+}
+
+// Test that tool and spindle speed carry over between the operations of a project
+TEST_F(CycleTimeEstimatorTest, Project) {
+    std::vector<TToolpathSequence> sequences(3);
+    sequences[0].addLine(TPoint(10.0, 0.0), TPoint(10.0, -10.0), 1, 600.0, 1000.0);
+    sequences[1].addLine(TPoint(10.0, 0.0), TPoint(10.0, -10.0), 1, 600.0, 1000.0);
+    sequences[1].addDwell(TPoint(10.0, -10.0), 0.5, 1, 1000.0);
+    sequences[2].addLine(TPoint(10.0, 0.0), TPoint(10.0, -10.0), 2, 600.0, 1500.0);
+
+    const ProjectCycleTime project = CycleTimeEstimator(machineConfig).estimateProject(sequences);
+    ASSERT_EQ(project.operations.size(), 3);
+    EXPECT_EQ(project.operations[0].toolChanges, 1);
+    EXPECT_EQ(project.operations[1].toolChanges, 0);
+    EXPECT_DOUBLE_EQ(project.operations[1].spindleTime, 0.0);
+    EXPECT_DOUBLE_EQ(project.operations[1].dwellTime, 0.5);
+    EXPECT_EQ(project.operations[2].toolChanges, 1);
+    EXPECT_DOUBLE_EQ(project.operations[2].spindleTime, 0.5);
+    EXPECT_EQ(project.total.toolChanges, 2);
+    EXPECT_DOUBLE_EQ(project.total.spindleTime, 1.5);
+    EXPECT_NEAR(project.total.total(), 3 * 1.1 + 0.5 + 10.0 + 1.5, 1e-9);
+}
+
+// Test cycle time formatting
+TEST_F(CycleTimeEstimatorTest, Format) {
+    EXPECT_EQ(formatCycleTime(0.0), "0:00");
+    EXPECT_EQ(formatCycleTime(83.4), "1:23");
+    EXPECT_EQ(formatCycleTime(3725.0), "1:02:05");
+}
@@ -0,0 +1,218 @@
+//
+// Unit tests for the streaming DXF reader
+//
+
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+#include "DXFStreamReader.h"
+#include "Line.h"
+
+class DXFStreamReaderTest : public ::testing::Test {
+protected:
+    static std::string entities(const std::string& body) {
+        return "  0\nSECTION\n  2\nHEADER\n  9\n$ACADVER\n  1\nAC1015\n  0\nENDSEC\n"
+               "  0\nSECTION\n  2\nENTITIES\n" + body + "  0\nENDSEC\n  0\nEOF\n";
+    }
+
+    static std::string line(const std::string& layer, double x1, double y1, double x2, double y2) {
+        return "  0\nLINE\n  8\n" + layer + "\n 10\n" + std::to_string(x1) + "\n 20\n" + std::to_string(y1) +
+               "\n 11\n" + std::to_string(x2) + "\n 21\n" + std::to_string(y2) + "\n";
+    }
+};
+
+// Test reading the same file the dime based loader is tested with
+TEST_F(DXFStreamReaderTest, LoadLinesFile) {
+    const Geometry geometry = loadDXFStreaming(std::filesystem::path(TEST_DATA_DIR) / "Lines.dxf");
+
+    ASSERT_EQ(geometry.segments.size(), 4);
+    const std::vector<Line> expectedLines = {
+        {{0, 0}, {50, 0}},
+        {{50, 0}, {50, 60}},
+        {{50, 60}, {0, 10}},
+        {{0, 10}, {0, 0}}
+    };
+    for (const Line& expected : expectedLines) {
+        EXPECT_TRUE(std::ranges::any_of(geometry.segments, [&](const SegmentView segment) { return segment == expected; }));
+    }
+}
+
+// Test arcs, circles, bulged polylines and splines
+TEST_F(DXFStreamReaderTest, LoadCurves) {
+    const Geometry arcs = loadDXFStreaming(std::filesystem::path(TEST_DATA_DIR) / "Arcs.dxf");
+    ASSERT_EQ(arcs.segments.size(), 4);
+    EXPECT_EQ(std::ranges::count(arcs.segments.kinds, SegmentKind::Arc), 3);
+    EXPECT_NEAR(arcs.segments.bulge[1], 1.0, 1e-9);
+
+    const Geometry polylines = loadDXFStreaming(std::filesystem::path(TEST_DATA_DIR) / "Polylines.dxf", {.splineTolerance = 0.001});
+    ASSERT_GE(polylines.segments.size(), 4);
+    EXPECT_EQ(polylines.segments.kinds[1], SegmentKind::Arc);
+    EXPECT_EQ(polylines.segments[polylines.segments.size() - 1].end(), Point(22.0, 0.0));
+}
+
+// Test old style POLYLINE entities with VERTEX records
+TEST_F(DXFStreamReaderTest, PolylineVertices) {
+    const std::string dxf = entities(
+        "  0\nPOLYLINE\n  8\n0\n 66\n1\n 70\n1\n"
+        "  0\nVERTEX\n  8\n0\n 10\n0.0\n 20\n0.0\n 42\n1.0\n"
+        "  0\nVERTEX\n  8\n0\n 10\n10.0\n 20\n0.0\n"
+        "  0\nVERTEX\n  8\n0\n 10\n10.0\n 20\n10.0\n"
+        "  0\nSEQEND\n  8\n0\n" + line("0", 5.0, 5.0, 6.0, 6.0));
+
+    DXFStreamReader reader = DXFStreamReader::fromBuffer(dxf);
+    SegmentStore segments;
+    const DXFStreamStatistics statistics = reader.read(segments);
+    ASSERT_EQ(segments.size(), 4);
+    EXPECT_EQ(segments.kinds[0], SegmentKind::Arc);
+    EXPECT_EQ(segments[2].end(), Point(0.0, 0.0));
+    EXPECT_EQ(segments.kinds[3], SegmentKind::Line);
+    EXPECT_EQ(statistics.entitiesRead, 2);
+    EXPECT_EQ(statistics.bytesRead, dxf.size() - std::string("  0\nEOF\n").size());
+}
+
+// Test that the control frame of a spline-fit POLYLINE is left out
+TEST_F(DXFStreamReaderTest, PolylineSkipsSplineFrame) {
+    const std::string dxf = entities(
+        "  0\nPOLYLINE\n  8\n0\n 66\n1\n 70\n4\n"
+        "  0\nVERTEX\n  8\n0\n 10\n0.0\n 20\n0.0\n 70\n16\n"
+        "  0\nVERTEX\n  8\n0\n 10\n5.0\n 20\n9.0\n 70\n16\n"
+        "  0\nVERTEX\n  8\n0\n 10\n0.0\n 20\n0.0\n 70\n8\n"
+        "  0\nVERTEX\n  8\n0\n 10\n5.0\n 20\n4.0\n 70\n8\n"
+        "  0\nVERTEX\n  8\n0\n 10\n10.0\n 20\n0.0\n 70\n8\n"
+        "  0\nSEQEND\n  8\n0\n");
+
+    SegmentStore segments;
+    DXFStreamReader::fromBuffer(dxf).read(segments);
+    ASSERT_EQ(segments.size(), 2);
+    EXPECT_EQ(segments[0].start(), Point(0.0, 0.0));
+    EXPECT_EQ(segments[0].end(), Point(5.0, 4.0));
+    EXPECT_EQ(segments[1].end(), Point(10.0, 0.0));
+
+    const std::vector<DXFLayerStatistics> layers = DXFStreamReader::fromBuffer(dxf).scanLayers();
+    ASSERT_EQ(layers.size(), 1);
+    EXPECT_EQ(layers[0].segments, 2);
+}
+
+// Test layer and entity type filters
+TEST_F(DXFStreamReaderTest, Filters) {
+    const std::string dxf = entities(
+        line("Profile", 0, 0, 1, 0) + line("Dimensions", 0, 1, 1, 1) +
+        "  0\nCIRCLE\n  8\nProfile\n 10\n0.0\n 20\n0.0\n 40\n1.0\n"
+        "  0\nTEXT\n  8\nProfile\n  1\nHello\n"
+        "  0\nINSERT\n  8\nProfile\n  2\nTitleBlock\n");
+
+    DXFStreamReader reader = DXFStreamReader::fromBuffer(dxf);
+    reader.setOptions({.layers = {"Profile"}});
+    SegmentStore segments;
+    DXFStreamStatistics statistics = reader.read(segments);
+    EXPECT_EQ(segments.size(), 3);
+    EXPECT_EQ(statistics.entitiesRead, 5);
+    EXPECT_EQ(statistics.entitiesSkipped, 3);
+    EXPECT_EQ(statistics.blockReferences, 1);
+
+    reader.setOptions({.layers = {"Profile"}, .entityTypes = {"LINE"}});
+    segments.clear();
+    reader.read(segments);
+    ASSERT_EQ(segments.size(), 1);
+    EXPECT_TRUE(segments[0] == Line(0, 0, 1, 0));
+}
+
+// Test Windows line endings and malformed input
+TEST_F(DXFStreamReaderTest, LineEndingsAndErrors) {
+    std::string dxf = entities(line("0", 1.5, 2.5, 3.5, 4.5));
+    std::string crlf;
+    for (const char c : dxf) {
+        if (c == '\n') crlf += '\r';
+        crlf += c;
+    }
+    SegmentStore segments;
+    DXFStreamReader::fromBuffer(crlf).read(segments);
+    ASSERT_EQ(segments.size(), 1);
+    EXPECT_EQ(segments[0].end(), Point(3.5, 4.5));
+
+    const std::string broken = entities("  0\nLINE\n 10\nabc\n");
+    EXPECT_THROW(DXFStreamReader::fromBuffer(broken).read(segments), std::runtime_error);
+    EXPECT_THROW(DXFStreamReader::fromBuffer("AutoCAD Binary DXF\r\n").read(segments), std::runtime_error);
+    EXPECT_THROW(DXFStreamReader(std::filesystem::path(TEST_DATA_DIR) / "missing.dxf"), std::runtime_error);
+}
+
+// Test progress reports and cancellation through the progress callback
+TEST_F(DXFStreamReaderTest, ProgressAndCancel) {
+    std::string body;
+    for (int i = 0; i < 3 * DXF_PROGRESS_INTERVAL; i++) {
+        body += line("0", i, 0, i + 1, 0);
+    }
+    const std::string dxf = entities(body);
+    DXFStreamReader reader = DXFStreamReader::fromBuffer(dxf);
+
+    std::vector<DXFStreamStatistics> reports;
+    reader.setProgressCallback([&](const DXFStreamStatistics& progress, const SegmentStore&) {
+        reports.push_back(progress);
+        return true;
+    });
+    SegmentStore segments;
+    reader.read(segments);
+    ASSERT_EQ(reports.size(), 4);
+    EXPECT_EQ(reports[0].entitiesRead, DXF_PROGRESS_INTERVAL);
+    EXPECT_LT(reports[0].bytesRead, reports[1].bytesRead);
+    EXPECT_EQ(reports.back().entitiesRead, 3 * DXF_PROGRESS_INTERVAL);
+    EXPECT_GE(reports.back().bytesRead, reports[2].bytesRead);
+    EXPECT_LE(reports.back().bytesRead, dxf.size());
+
+    reader.setProgressCallback([](const DXFStreamStatistics&, const SegmentStore& read) {
+        return read.size() < DXF_PROGRESS_INTERVAL;
+    });
+    segments.clear();
+    EXPECT_THROW(reader.read(segments), DXFImportCancelled);
+    EXPECT_LT(segments.size(), 3 * DXF_PROGRESS_INTERVAL);
+}
+
+// Test per-layer counts of the layer scan
+TEST_F(DXFStreamReaderTest, ScanLayers) {
+    const std::string dxf = entities(
+        line("Profile", 0, 0, 1, 0) +
+        "  0\nCIRCLE\n  8\nProfile\n 10\n0.0\n 20\n0.0\n 40\n1.0\n"
+        "  0\nLWPOLYLINE\n  8\nHatch\n 70\n1\n 10\n0.0\n 20\n0.0\n 10\n1.0\n 20\n0.0\n 10\n1.0\n 20\n1.0\n"
+        "  0\nPOLYLINE\n  8\nHatch\n 70\n0\n"
+        "  0\nVERTEX\n  8\nHatch\n 10\n0.0\n 20\n0.0\n"
+        "  0\nVERTEX\n  8\nHatch\n 10\n1.0\n 20\n0.0\n"
+        "  0\nVERTEX\n  8\nHatch\n 10\n2.0\n 20\n0.0\n"
+        "  0\nSEQEND\n  8\nHatch\n"
+        "  0\nTEXT\n  8\nDimensions\n  1\n42\n"
+        "  0\nLINE\n 10\n0.0\n 20\n0.0\n 11\n1.0\n 21\n1.0\n");
+
+    const std::vector<DXFLayerStatistics> layers = DXFStreamReader::fromBuffer(dxf).scanLayers();
+    ASSERT_EQ(layers.size(), 4);
+    EXPECT_EQ(layers[0].name, "0");
+    EXPECT_EQ(layers[0].segments, 1);
+    EXPECT_EQ(layers[1].name, "Dimensions");
+    EXPECT_EQ(layers[1].entities, 1);
+    EXPECT_EQ(layers[1].segments, 0);
+    EXPECT_EQ(layers[2].name, "Hatch");
+    EXPECT_EQ(layers[2].entities, 2);
+    EXPECT_EQ(layers[2].segments, 5);
+    EXPECT_EQ(layers[3].name, "Profile");
+    EXPECT_EQ(layers[3].segments, 3);
+
+    // Entities without a layer code are on layer 0
+    DXFStreamReader reader = DXFStreamReader::fromBuffer(dxf);
+    reader.setOptions({.layers = {"0"}});
+    SegmentStore segments;
+    reader.read(segments);
+    ASSERT_EQ(segments.size(), 1);
+    EXPECT_EQ(segments[0].end(), Point(1.0, 1.0));
+}
+
+// Test the options hash used in cache keys
+TEST_F(DXFStreamReaderTest, OptionsHash) {
+    const DXFImportOptions options{.layers = {"A", "B"}, .entityTypes = {"LINE"}};
+    EXPECT_EQ(options.hash(), (DXFImportOptions{.layers = {"B", "A"}, .entityTypes = {"LINE"}}.hash()));
+    EXPECT_NE(options.hash(), (DXFImportOptions{.layers = {"A"}, .entityTypes = {"LINE"}}.hash()));
+    EXPECT_NE(options.hash(), (DXFImportOptions{.layers = {"LINE"}, .entityTypes = {"A", "B"}}.hash()));
+    EXPECT_NE(options.hash(), (DXFImportOptions{.layers = {"A", "B"}, .entityTypes = {"LINE"}, .splineTolerance = 0.1}.hash()));
+    EXPECT_TRUE(DXFImportOptions().keepsLayer("anything"));
+    EXPECT_FALSE(options.keepsEntityType("ARC"));
+}
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <filesystem>
+#include <ranges>
 
 #include "Line.h"
 #include "../src/utils/DXFUtils.h"
@@ -37,7 +38,47 @@ TEST_F(DXFUtilsTest, LoadDXFFile) {
     };
 
     for (size_t i = 0; i < expectedLines.size(); i++) {
-        bool found = std::ranges::any_of(geometry.segments, [&](const auto& segment) { return *segment == expectedLines[i];});
+        bool found = std::ranges::any_of(geometry.segments, [&](const SegmentView segment) { return segment == expectedLines[i];});
         EXPECT_TRUE(found);
     }
-}
\ No newline at end of file
+}
+// Test loading ARC and CIRCLE entities as native arcs
+TEST_F(DXFUtilsTest, LoadArcs) {
+    std::filesystem::path dxfPath = std::filesystem::path(TEST_DATA_DIR) / "Arcs.dxf";
+
+    Geometry geometry = loadDXF(dxfPath);
+
+    // One line, one arc and a circle split into two half circles
+    ASSERT_EQ(geometry.segments.size(), 4);
+    EXPECT_EQ(std::ranges::count(geometry.segments.kinds, SegmentKind::Arc), 3);
+
+    const auto arc = std::ranges::find_if(geometry.segments, [](const SegmentView segment) {
+        return segment.kind() == SegmentKind::Arc && segment.start().x < 20.0;
+    });
+    ASSERT_NE(arc, geometry.segments.end());
+    EXPECT_NEAR((*arc).start().x, 10.0, 1e-9);
+    EXPECT_NEAR((*arc).start().y, 0.0, 1e-9);
+    EXPECT_NEAR((*arc).end().y, 10.0, 1e-9);
+    EXPECT_NEAR((*arc).bulge(), 1.0, 1e-9);
+    EXPECT_NEAR((*arc).distance(Point(15.0, 5.0)), 0.0, 1e-9);
+}
+
+// Test loading polylines with bulges and tessellated splines
+TEST_F(DXFUtilsTest, LoadPolylinesAndSplines) {
+    std::filesystem::path dxfPath = std::filesystem::path(TEST_DATA_DIR) / "Polylines.dxf";
+
+    Geometry geometry = loadDXF(dxfPath, {.splineTolerance = 0.001});
+
+    ASSERT_GE(geometry.segments.size(), 4);
+    EXPECT_TRUE(geometry.segments[0] == Line(0.0, 0.0, 10.0, 0.0));
+    ASSERT_EQ(geometry.segments.kinds[1], SegmentKind::Arc);
+    EXPECT_DOUBLE_EQ(geometry.segments.bulge[1], 1.0);
+
+    // The spline follows its curve from (20, 0) through (21, 1) to (22, 0)
+    const SegmentStore& segments = geometry.segments;
+    EXPECT_EQ(segments[2].start(), Point(20.0, 0.0));
+    EXPECT_EQ(segments[segments.size() - 1].end(), Point(22.0, 0.0));
+    EXPECT_TRUE(std::ranges::all_of(std::views::iota(size_t{2}, segments.size()), [&](const size_t i) {
+        return segments.kinds[i] == SegmentKind::Line;
+    }));
+}
@@ -0,0 +1,133 @@
+//
+// Unit tests for the imported geometry cache
+//
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <spdlog/fmt/fmt.h>
+
+#include "GeometryCache.h"
+#include "Hash.h"
+
+class GeometryCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path directory;
+    Geometry geometry;
+
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path() /
+                    ("turnlab-cache-test-" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(directory);
+
+        geometry.segments.addLine(0.0, 0.0, 10.0, 0.0);
+        geometry.segments.addArc(10.0, 0.0, 10.0, 5.0, 0.5);
+        geometry.segments.addLine(10.0, 5.0, 0.0, 5.0);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    static void expectEqual(const Geometry& actual, const Geometry& expected) {
+        const SegmentStore& a = actual.segments;
+        const SegmentStore& e = expected.segments;
+        ASSERT_EQ(a.size(), e.size());
+        EXPECT_EQ(a.kinds, e.kinds);
+        EXPECT_EQ(a.x1, e.x1);
+        EXPECT_EQ(a.y1, e.y1);
+        EXPECT_EQ(a.x2, e.x2);
+        EXPECT_EQ(a.y2, e.y2);
+        EXPECT_EQ(a.bulge, e.bulge);
+    }
+};
+
+// Test the binary format round trip
+TEST_F(GeometryCacheTest, BinaryRoundTrip) {
+    std::stringstream stream;
+    writeGeometry(stream, geometry);
+    // Header plus one kind byte and five doubles per segment
+    EXPECT_EQ(stream.str().size(), 16 + 3 * 41);
+    expectEqual(readGeometry(stream), geometry);
+}
+
+// Test invalid data is rejected
+TEST_F(GeometryCacheTest, RejectsInvalidData) {
+    std::stringstream garbage("not geometry at all");
+    EXPECT_THROW(readGeometry(garbage), std::runtime_error);
+
+    std::stringstream stream;
+    writeGeometry(stream, geometry);
+    std::string data = stream.str();
+    data.resize(data.size() - 8);
+    std::stringstream truncated(data);
+    EXPECT_THROW(readGeometry(truncated), std::runtime_error);
+}
+
+// Test store and load through the cache directory
+TEST_F(GeometryCacheTest, StoreAndLoad) {
+    const GeometryCache cache(directory);
+    const uint64_t key = GeometryCache::key("  0\nEOF\n");
+    EXPECT_FALSE(cache.load(key).has_value());
+
+    cache.store(key, geometry);
+    const auto loaded = cache.load(key);
+    ASSERT_TRUE(loaded.has_value());
+    expectEqual(*loaded, geometry);
+}
+
+// Test keys depend on content and import options
+TEST_F(GeometryCacheTest, KeyDependsOnContentAndOptions) {
+    EXPECT_EQ(GeometryCache::key("abc"), GeometryCache::key("abc"));
+    EXPECT_NE(GeometryCache::key("abc"), GeometryCache::key("abd"));
+    EXPECT_NE(GeometryCache::key("abc", 1), GeometryCache::key("abc", 2));
+
+    // Every byte of a long buffer affects the hash, including the tail
+    std::string content(1000, 'x');
+    const uint64_t hash = contentHash(content);
+    content[3] = 'y';
+    EXPECT_NE(contentHash(content), hash);
+    content[3] = 'x';
+    content[999] = 'y';
+    EXPECT_NE(contentHash(content), hash);
+}
+
+// Test corrupt entries are discarded
+TEST_F(GeometryCacheTest, CorruptEntryIsAMiss) {
+    const GeometryCache cache(directory);
+    cache.store(1, geometry);
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        std::ofstream(entry.path(), std::ios::binary | std::ios::trunc) << "corrupt";
+    }
+    EXPECT_FALSE(cache.load(1).has_value());
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+}
+
+// Test the least recently used entries are evicted once the size limit is exceeded
+TEST_F(GeometryCacheTest, EvictsLeastRecentlyUsed) {
+    // Room for two entries of this geometry
+    const GeometryCache cache(directory, 2 * (16 + 3 * 41));
+    const auto now = std::filesystem::file_time_type::clock::now();
+    const auto age = [&](const uint64_t key, const int minutes) {
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.path().stem().string() == fmt::format("{:016x}", key)) {
+                std::filesystem::last_write_time(entry.path(), now - std::chrono::minutes(minutes));
+            }
+        }
+    };
+
+    cache.store(1, geometry);
+    age(1, 10);
+    cache.store(2, geometry);
+    age(2, 20);
+    // Loading refreshes entry 2, so entry 1 is now the least recently used
+    ASSERT_TRUE(cache.load(2).has_value());
+    cache.store(3, geometry);
+
+    EXPECT_FALSE(cache.load(1).has_value());
+    EXPECT_TRUE(cache.load(2).has_value());
+    EXPECT_TRUE(cache.load(3).has_value());
+}
@@ -0,0 +1,92 @@
+//
+// Unit tests for duplicate and overlap removal
+//
+
+#include <gtest/gtest.h>
+
+#include "GeometryCleanup.h"
+#include "Line.h"
+#include "SegmentStore.h"
+
+class GeometryCleanupTest : public ::testing::Test {
+protected:
+    static bool contains(const SegmentStore& segments, const Line& line) {
+        for (const SegmentView segment : segments) {
+            if (segment == line) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Test exact, reversed and near duplicates are removed, distinct arcs kept
+TEST_F(GeometryCleanupTest, RemovesDuplicates) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 10.0, 0.0);
+    segments.addLine(0.0, 0.0, 10.0, 0.0);
+    segments.addLine(10.0, 0.0, 0.0, 0.0);
+    segments.addLine(10.0, 1e-8, 10.0, 5.0);
+    segments.addLine(10.0, 0.0, 10.0, 5.0 + 1e-8);
+    // Two halves of a circle share endpoints but aren't duplicates
+    segments.addArc(0.0, 10.0, 10.0, 10.0, 1.0);
+    segments.addArc(10.0, 10.0, 0.0, 10.0, 1.0);
+    // The same arc reversed is
+    segments.addArc(10.0, 10.0, 0.0, 10.0, -1.0);
+
+    const CleanupResult result = cleanupSegments(segments);
+    EXPECT_EQ(result.duplicatesRemoved, 4);
+    EXPECT_EQ(result.removed(), 4);
+    ASSERT_EQ(result.segments.size(), 4);
+    EXPECT_TRUE(result.segments[0] == Line(0.0, 0.0, 10.0, 0.0));
+    EXPECT_EQ(result.segments.kinds[2], SegmentKind::Arc);
+    EXPECT_EQ(result.segments.kinds[3], SegmentKind::Arc);
+    EXPECT_DOUBLE_EQ(result.segments.bulge[3], 1.0);
+}
+
+// Test collinear overlapping fragments are joined and touching ones kept
+TEST_F(GeometryCleanupTest, JoinsCollinearOverlaps) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 6.0, 0.0);
+    segments.addLine(4.0, 0.0, 10.0, 0.0);
+    segments.addLine(8.0, 0.0, 2.0, 0.0);
+    // Touches the merged line end to end
+    segments.addLine(10.0, 0.0, 15.0, 0.0);
+    // Parallel but offset
+    segments.addLine(0.0, 1.0, 10.0, 1.0);
+    // Vertical overlap
+    segments.addLine(0.0, 0.0, 0.0, -5.0);
+    segments.addLine(0.0, -3.0, 0.0, -8.0);
+
+    const CleanupResult result = cleanupSegments(segments);
+    EXPECT_EQ(result.overlapsMerged, 3);
+    ASSERT_EQ(result.segments.size(), 4);
+    EXPECT_TRUE(contains(result.segments, Line(0.0, 0.0, 10.0, 0.0)));
+    EXPECT_TRUE(contains(result.segments, Line(10.0, 0.0, 15.0, 0.0)));
+    EXPECT_TRUE(contains(result.segments, Line(0.0, 1.0, 10.0, 1.0)));
+    EXPECT_TRUE(contains(result.segments, Line(0.0, 0.0, 0.0, -8.0)));
+}
+
+// Test lines with directions on both sides of the folding angle are still found collinear
+TEST_F(GeometryCleanupTest, NearlyHorizontalWrap) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 10.0, 1e-9);
+    segments.addLine(5.0, 0.0, 15.0, -1e-9);
+
+    const CleanupResult result = cleanupSegments(segments);
+    EXPECT_EQ(result.overlapsMerged, 1);
+    ASSERT_EQ(result.segments.size(), 1);
+    EXPECT_NEAR(result.segments.x2[0], 15.0, 1e-6);
+}
+
+// Test degenerate segments are dropped
+TEST_F(GeometryCleanupTest, RemovesDegenerate) {
+    SegmentStore segments;
+    segments.addLine(1.0, 1.0, 1.0, 1.0);
+    segments.addLine(0.0, 0.0, 1.0, 0.0);
+
+    const CleanupResult result = cleanupSegments(segments);
+    EXPECT_EQ(result.degenerateRemoved, 1);
+    ASSERT_EQ(result.segments.size(), 1);
+    EXPECT_TRUE(result.segments[0] == Line(0.0, 0.0, 1.0, 0.0));
+}
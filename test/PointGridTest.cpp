@@ -0,0 +1,72 @@
+//
+// Unit tests for PointGrid and endpoint welding
+//
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "PointGrid.h"
+#include "SegmentStore.h"
+
+class PointGridTest : public ::testing::Test {
+};
+
+// Test that shared and nearly shared endpoints are welded into one vertex
+TEST_F(PointGridTest, WeldEndpoints) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 10.0, 0.0);
+    segments.addLine(10.0 + 1e-9, 0.0, 10.0, 5.0);
+    segments.addLine(10.0, 5.0, 0.0, 0.0);
+    segments.addLine(20.0, 20.0, 30.0, 20.0);
+
+    const WeldedVertices welded = weldEndpoints(segments, 1e-6);
+    EXPECT_EQ(welded.points.size(), 5);
+    EXPECT_EQ(welded.startVertex[0], welded.endVertex[2]);
+    EXPECT_EQ(welded.endVertex[0], welded.startVertex[1]);
+    EXPECT_EQ(welded.endVertex[1], welded.startVertex[2]);
+    EXPECT_NE(welded.startVertex[3], welded.endVertex[3]);
+    EXPECT_EQ(welded.points[welded.endVertex[0]], Point(10.0, 0.0));
+}
+
+// Test that points further apart than the tolerance stay separate
+TEST_F(PointGridTest, WeldRespectsTolerance) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 1.0, 0.0);
+    segments.addLine(1.001, 0.0, 2.0, 0.0);
+    EXPECT_EQ(weldEndpoints(segments, 1e-6).points.size(), 4);
+    EXPECT_EQ(weldEndpoints(segments, 0.01).points.size(), 3);
+}
+
+// Test nearest point queries against a linear scan
+TEST_F(PointGridTest, NearestMatchesBruteForce) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> pos(-50.0, 50.0);
+    std::vector<Point> points;
+    for (int i = 0; i < 3000; i++) {
+        points.emplace_back(pos(rng), pos(rng));
+    }
+    const PointGrid grid(points);
+    EXPECT_EQ(grid.size(), points.size());
+
+    for (int i = 0; i < 300; i++) {
+        const Point query(pos(rng), pos(rng));
+        for (double tolerance : {0.2, 2.0, 500.0}) {
+            std::optional<size_t> expected;
+            double bestDistance = tolerance;
+            for (size_t j = 0; j < points.size(); j++) {
+                const double d = std::hypot(points[j].x - query.x, points[j].y - query.y);
+                if (d < bestDistance) {
+                    bestDistance = d;
+                    expected = j;
+                }
+            }
+            EXPECT_EQ(grid.nearest(query, tolerance), expected);
+        }
+    }
+}
+
+// Test queries on an empty grid
+TEST_F(PointGridTest, EmptyGrid) {
+    const PointGrid grid;
+    EXPECT_FALSE(grid.nearest(Point(0.0, 0.0), 10.0).has_value());
+}
@@ -0,0 +1,196 @@
+//
+// Unit tests for profile following roughing
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "toolpath/CycleTimeEstimator.h"
+#include "toolpath/RoughingBoundary.h"
+#include "toolpath/ToolpathGenerator.h"
+
+namespace {
+// Shaft turned down from a radius of 20, stepping up from 10 to 15 and 18 towards the chuck
+SegmentStore steppedShaft() {
+    SegmentStore segments;
+    segments.addLine(0.0, 10.0, -20.0, 10.0);
+    segments.addLine(-20.0, 10.0, -20.0, 15.0);
+    segments.addLine(-20.0, 15.0, -60.0, 15.0);
+    segments.addLine(-60.0, 15.0, -60.0, 18.0);
+    segments.addLine(-60.0, 18.0, -100.0, 18.0);
+    return segments;
+}
+
+OperationConfiguration shaftTurning() {
+    OperationConfiguration operation;
+    operation.operationType = OperationType::Turning;
+    operation.geometrySelection = {0, 1, 2, 3, 4};
+    operation.axialStartPosition = 0.0;
+    operation.axialEndPosition = -100.0;
+    operation.outerDistance = 20.0;
+    operation.innerDistance = 10.0;
+    operation.stepover = 1.0;
+    return operation;
+}
+
+Contour shaftProfile() {
+    return buildContour(steppedShaft(), {0, 1, 2, 3, 4});
+}
+}
+
+// Test that passes are clipped where the profile rises above them
+TEST(RoughingBoundaryTest, SpansOfSteppedProfile) {
+    const RoughingBoundary boundary(shaftProfile(), 0.0, -100.0, 1.0);
+
+    std::vector<PassSpan> spans = boundary.spansAt(19.0);
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_DOUBLE_EQ(spans[0].start, 0.0);
+    EXPECT_DOUBLE_EQ(spans[0].end, -100.0);
+
+    spans = boundary.spansAt(16.0);
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_DOUBLE_EQ(spans[0].end, -60.0);
+
+    // A pass level with the profile finishes it
+    spans = boundary.spansAt(15.0);
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_DOUBLE_EQ(spans[0].end, -60.0);
+
+    spans = boundary.spansAt(10.0);
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_DOUBLE_EQ(spans[0].end, -20.0);
+
+    EXPECT_TRUE(boundary.spansAt(9.0).empty());
+}
+
+// Test that a groove splits passes and that spans follow the cutting direction
+TEST(RoughingBoundaryTest, SpansAroundGroove) {
+    SegmentStore segments;
+    segments.addLine(0.0, 15.0, -20.0, 15.0);
+    segments.addLine(-20.0, 15.0, -20.0, 10.0);
+    segments.addLine(-20.0, 10.0, -30.0, 10.0);
+    segments.addLine(-30.0, 10.0, -30.0, 15.0);
+    segments.addLine(-30.0, 15.0, -50.0, 15.0);
+    const Contour profile = buildContour(segments, {0, 1, 2, 3, 4});
+
+    std::vector<PassSpan> spans = RoughingBoundary(profile, 0.0, -50.0, 1.0).spansAt(12.0);
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_DOUBLE_EQ(spans[0].start, -20.0);
+    EXPECT_DOUBLE_EQ(spans[0].end, -30.0);
+
+    // Stock on the far side of the centerline, cutting from the chuck end
+    Contour mirrored = profile;
+    for (auto& element : mirrored) {
+        element.start.x = -element.start.x;
+        element.end.x = -element.end.x;
+    }
+    spans = RoughingBoundary(mirrored, -50.0, 0.0, -1.0).spansAt(-16.0);
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_DOUBLE_EQ(spans[0].start, -50.0);
+    EXPECT_DOUBLE_EQ(spans[0].end, 0.0);
+}
+
+// Test that arcs are flattened within tolerance
+TEST(RoughingBoundaryTest, FlattenArc) {
+    SegmentStore segments;
+    // Quarter circle of radius 10 around (z -10, x 0)
+    segments.addArc(0.0, 0.0, -10.0, 10.0, 0.41421356237309503);
+    const Contour contour = buildContour(segments, {0});
+
+    const std::vector<TPoint> points = flattenContour(contour, 1e-3);
+    ASSERT_GT(points.size(), 10);
+    EXPECT_NEAR(points.front().z, 0.0, 1e-9);
+    EXPECT_NEAR(points.back().x, 10.0, 1e-9);
+    for (size_t i = 1; i < points.size(); i++) {
+        EXPECT_NEAR(std::hypot(points[i].x, points[i].z + 10.0), 10.0, 1e-9);
+        // Chord midpoints stay within tolerance of the arc
+        const double midX = (points[i - 1].x + points[i].x) / 2.0;
+        const double midZ = (points[i - 1].z + points[i].z) / 2.0;
+        EXPECT_LE(10.0 - std::hypot(midX, midZ + 10.0), 1e-3);
+    }
+}
+
+// Test that profile roughing never cuts below the profile and halves the cycle time of the shaft
+TEST(RoughingBoundaryTest, ProfileTurningRemovesAirCuts) {
+    const SegmentStore segments = steppedShaft();
+    const OperationConfiguration operation = shaftTurning();
+    const MachineConfig machineConfig;
+
+    const TToolpathSequence rectangular = ToolpathGenerator::generateToolpath(operation, machineConfig);
+    const TToolpathSequence profile = ToolpathGenerator::generateToolpath(operation, machineConfig, segments);
+
+    // Passes may run up to the foot of each shoulder
+    const auto floor = [](const double z) { return z >= -20.0 - 1e-9 ? 10.0 : z >= -60.0 - 1e-9 ? 15.0 : 18.0; };
+    for (const TMove& move : profile.moves()) {
+        if (move.kind == TMoveKind::Feed) {
+            EXPECT_GE(move.start.x, floor(move.start.z) - 1e-9);
+            EXPECT_GE(move.end.x, floor(move.end.z) - 1e-9);
+        }
+    }
+
+    CycleTimeEstimator estimator(machineConfig);
+    const double before = estimator.estimate(rectangular).total();
+    const double after = estimator.estimate(profile).total();
+    EXPECT_LT(after, 0.6 * before);
+}
+
+// Test that the stock allowance keeps the passes off the profile
+TEST(RoughingBoundaryTest, ProfileTurningLeavesAllowance) {
+    OperationConfiguration operation = shaftTurning();
+    operation.stockAllowance = 0.5;
+
+    const TToolpathSequence toolpath = ToolpathGenerator::generateToolpath(operation, MachineConfig(), steppedShaft());
+    double innermost = 20.0;
+    for (const TMove& move : toolpath.moves()) {
+        if (move.kind == TMoveKind::Feed) {
+            innermost = std::min(innermost, move.end.x);
+        }
+    }
+    EXPECT_GE(innermost, 10.5 - 1e-9);
+}
+
+// Test that floors off the stepover grid are roughed down to the allowance and no further
+TEST(RoughingBoundaryTest, ProfileTurningReachesFloorsOffStepover) {
+    SegmentStore segments;
+    segments.addLine(0.0, 10.0, -20.0, 10.0);
+    segments.addLine(-20.0, 10.0, -20.0, 15.0);
+    segments.addLine(-20.0, 15.0, -60.0, 15.0);
+    OperationConfiguration operation;
+    operation.operationType = OperationType::Turning;
+    operation.geometrySelection = {0, 1, 2};
+    operation.axialStartPosition = 0.0;
+    operation.axialEndPosition = -60.0;
+    operation.outerDistance = 20.0;
+    operation.innerDistance = 10.0;
+    operation.stepover = 2.0;
+    operation.stockAllowance = 0.3;
+
+    const TToolpathSequence toolpath = ToolpathGenerator::generateToolpath(operation, MachineConfig(), segments);
+
+    // Deepest cut over each floor
+    double smallFloor = 20.0;
+    double largeFloor = 20.0;
+    for (const TMove& move : toolpath.moves()) {
+        if (move.kind != TMoveKind::Feed || move.start.x != move.end.x) {
+            continue;
+        }
+        const double from = std::max(move.start.z, move.end.z);
+        const double to = std::min(move.start.z, move.end.z);
+        if (from > -10.0 && to < -10.0) {
+            smallFloor = std::min(smallFloor, move.start.x);
+        }
+        if (from > -40.0 && to < -40.0) {
+            largeFloor = std::min(largeFloor, move.start.x);
+        }
+    }
+    EXPECT_NEAR(smallFloor, 10.3, 1e-9);
+    EXPECT_NEAR(largeFloor, 15.3, 1e-9);
+
+    const RoughingBoundary boundary(offsetContour(buildContour(segments, {0, 1, 2}), 0.3), 0.0, -60.0, 1.0);
+    const std::vector<double> floors = boundary.floors();
+    ASSERT_EQ(floors.size(), 2);
+    EXPECT_NEAR(floors[0], 15.3, 1e-9);
+    EXPECT_NEAR(floors[1], 10.3, 1e-9);
+}
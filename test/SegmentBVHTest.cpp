@@ -0,0 +1,100 @@
+//
+// Unit tests for SegmentBVH
+//
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "SegmentBVH.h"
+#include "SegmentStore.h"
+
+class SegmentBVHTest : public ::testing::Test {
+protected:
+    SegmentStore segments;
+
+    void SetUp() override {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> pos(-100.0, 100.0);
+        std::uniform_real_distribution<double> len(-5.0, 5.0);
+        for (int i = 0; i < 2000; i++) {
+            const double x = pos(rng);
+            const double y = pos(rng);
+            segments.addLine(x, y, x + len(rng), y + len(rng));
+        }
+    }
+
+    std::optional<size_t> bruteForceNearest(const Point& p, double maxDistance) const {
+        std::optional<size_t> best;
+        double bestDistance = maxDistance;
+        for (size_t i = 0; i < segments.size(); i++) {
+            const double d = segments.distance(i, p);
+            if (d < bestDistance || (d == bestDistance && !best)) {
+                bestDistance = d;
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+// Test that nearest queries agree with a linear scan
+TEST_F(SegmentBVHTest, NearestMatchesBruteForce) {
+    const SegmentBVH tree(segments);
+    EXPECT_EQ(tree.size(), segments.size());
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> pos(-110.0, 110.0);
+    for (int i = 0; i < 500; i++) {
+        const Point p(pos(rng), pos(rng));
+        for (double tolerance : {0.5, 3.0, 1000.0}) {
+            const auto expected = bruteForceNearest(p, tolerance);
+            const auto actual = tree.nearest(p, tolerance);
+            ASSERT_EQ(expected.has_value(), actual.has_value());
+            if (expected) {
+                EXPECT_DOUBLE_EQ(segments.distance(*actual, p), segments.distance(*expected, p));
+            }
+        }
+    }
+}
+
+// Test that nothing is returned outside the tolerance
+TEST_F(SegmentBVHTest, NearestOutsideTolerance) {
+    SegmentStore store;
+    store.addLine(0.0, 0.0, 10.0, 0.0);
+    const SegmentBVH tree(store);
+    EXPECT_FALSE(tree.nearest(Point(5.0, 2.0), 1.0).has_value());
+    EXPECT_EQ(tree.nearest(Point(5.0, 2.0), 2.0), 0);
+}
+
+// Test rectangle queries against a linear scan
+TEST_F(SegmentBVHTest, RectangleQuery) {
+    const SegmentBVH tree(segments);
+    const BoundingBox rect(-20.0, 10.0, 35.0, 40.0);
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < segments.size(); i++) {
+        if (segments.intersects(i, rect)) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(tree.query(rect), expected);
+}
+
+// Test that a segment crossing a rectangle without an endpoint inside is found
+TEST_F(SegmentBVHTest, RectangleQueryCrossingSegment) {
+    SegmentStore store;
+    store.addLine(-10.0, 0.0, 10.0, 0.0);
+    store.addLine(-10.0, 5.0, -5.0, 10.0);
+    const SegmentBVH tree(store);
+    EXPECT_EQ(tree.query(BoundingBox(-1.0, -1.0, 1.0, 1.0)), std::vector<size_t>{0});
+    EXPECT_TRUE(tree.query(BoundingBox(-4.0, 4.0, 0.0, 6.0)).empty());
+}
+
+// Test an empty tree
+TEST_F(SegmentBVHTest, EmptyTree) {
+    const SegmentBVH tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_FALSE(tree.nearest(Point(0.0, 0.0), 100.0).has_value());
+    EXPECT_TRUE(tree.query(BoundingBox(-1.0, -1.0, 1.0, 1.0)).empty());
+}
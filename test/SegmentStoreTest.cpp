@@ -0,0 +1,119 @@
+//
+// Unit tests for SegmentStore and Geometry storage
+//
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "Geometry.h"
+#include "Line.h"
+#include "SegmentStore.h"
+
+class SegmentStoreTest : public ::testing::Test {
+protected:
+    SegmentStore store;
+
+    void SetUp() override {
+        store.addLine(0.0, 0.0, 10.0, 0.0);
+        store.addLine(Point(10.0, 0.0), Point(10.0, 5.0));
+        store.addLine(Line(10.0, 5.0, 0.0, 5.0));
+    }
+};
+
+// Test that segments are stored as parallel coordinate arrays
+TEST_F(SegmentStoreTest, AddLineStoresEndpoints) {
+    ASSERT_EQ(store.size(), 3);
+    EXPECT_EQ(store.kinds[1], SegmentKind::Line);
+    EXPECT_DOUBLE_EQ(store.x1[1], 10.0);
+    EXPECT_DOUBLE_EQ(store.y1[1], 0.0);
+    EXPECT_DOUBLE_EQ(store.x2[1], 10.0);
+    EXPECT_DOUBLE_EQ(store.y2[1], 5.0);
+}
+
+// Test the view API used by callers
+TEST_F(SegmentStoreTest, ViewAccessors) {
+    const SegmentView view = store[2];
+    EXPECT_EQ(view.index(), 2);
+    EXPECT_EQ(view.kind(), SegmentKind::Line);
+    EXPECT_EQ(view.start(), Point(10.0, 5.0));
+    EXPECT_EQ(view.end(), Point(0.0, 5.0));
+
+    const auto line = view.asLine();
+    ASSERT_TRUE(line.has_value());
+    EXPECT_TRUE(*line == Line(10.0, 5.0, 0.0, 5.0));
+    EXPECT_TRUE(view == Line(0.0, 5.0, 10.0, 5.0));
+}
+
+// Test distance matches the Line implementation
+TEST_F(SegmentStoreTest, DistanceMatchesLine) {
+    const Point p(4.0, 2.0);
+    for (size_t i = 0; i < store.size(); i++) {
+        EXPECT_DOUBLE_EQ(store.distance(i, p), store[i].asLine()->distance(p));
+    }
+    EXPECT_DOUBLE_EQ(store.distance(0, p), 2.0);
+}
+
+// Test iteration over the store
+TEST_F(SegmentStoreTest, Iteration) {
+    size_t count = 0;
+    for (const SegmentView segment : store) {
+        EXPECT_EQ(segment.index(), count);
+        count++;
+    }
+    EXPECT_EQ(count, store.size());
+    EXPECT_TRUE(std::ranges::any_of(store, [](const SegmentView s) { return s == Line(10.0, 0.0, 10.0, 5.0); }));
+}
+
+// Test adding through the polymorphic Segment interface
+TEST_F(SegmentStoreTest, AddSegment) {
+    const Line line(1.0, 2.0, 3.0, 4.0);
+    const size_t index = store.add(static_cast<const Segment&>(line));
+    EXPECT_EQ(index, 3);
+    EXPECT_TRUE(store[index] == line);
+}
+
+// Test clearing the store
+TEST_F(SegmentStoreTest, Clear) {
+    store.clear();
+    EXPECT_TRUE(store.empty());
+    EXPECT_TRUE(store.x1.empty());
+    EXPECT_TRUE(store.y2.empty());
+}
+
+// Test Geometry copies are independent
+TEST_F(SegmentStoreTest, GeometryCopy) {
+    Geometry original(store);
+    Geometry copy = original;
+    copy.segments.x1[0] = 42.0;
+    EXPECT_DOUBLE_EQ(original.segments.x1[0], 0.0);
+    EXPECT_EQ(copy.segments.size(), original.segments.size());
+}
+
+// Test Geometry JSON round trip keeps the Line format
+TEST_F(SegmentStoreTest, GeometryJsonRoundTrip) {
+    const Geometry original(store);
+    const nlohmann::json j = original;
+    ASSERT_EQ(j.size(), 3);
+    EXPECT_EQ(j[0]["type"], "Line");
+
+    const Geometry loaded = j.get<Geometry>();
+    ASSERT_EQ(loaded.segments.size(), 3);
+    for (size_t i = 0; i < loaded.segments.size(); i++) {
+        EXPECT_EQ(loaded.segments[i].start(), original.segments[i].start());
+        EXPECT_EQ(loaded.segments[i].end(), original.segments[i].end());
+    }
+}
+
+// Test polylines become lines and bulge arcs
+TEST_F(SegmentStoreTest, AddPolyline) {
+    SegmentStore polyline;
+    const size_t added = polyline.addPolyline({{0.0, 0.0}, {10.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}}, {0.0, 0.0, 1.0, 0.0}, true);
+    // The repeated vertex is skipped, the closing segment is added
+    ASSERT_EQ(added, 3);
+    EXPECT_EQ(polyline.kinds[0], SegmentKind::Line);
+    EXPECT_EQ(polyline.kinds[1], SegmentKind::Arc);
+    EXPECT_DOUBLE_EQ(polyline.bulge[1], 1.0);
+    EXPECT_EQ(polyline[2].start(), Point(10.0, 10.0));
+    EXPECT_EQ(polyline[2].end(), Point(0.0, 0.0));
+}
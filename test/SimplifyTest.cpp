@@ -0,0 +1,61 @@
+//
+// Unit tests for profile simplification
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "SegmentStore.h"
+#include "Simplify.h"
+
+// Test Douglas-Peucker keeps the corners of a noisy polyline
+TEST(SimplifyTest, DouglasPeuckerKeepsCorners) {
+    const std::vector<Point> points = {{0.0, 0.0}, {1.0, 0.001}, {2.0, -0.001}, {3.0, 0.0}, {3.0, 1.0}, {3.001, 2.0}, {3.0, 3.0}};
+    const std::vector<size_t> kept = douglasPeucker(points, 0.01);
+    EXPECT_EQ(kept, (std::vector<size_t>{0, 3, 6}));
+    EXPECT_EQ(douglasPeucker(points, 0.0).size(), points.size());
+}
+
+// Test a dense arc approximation is reduced within the tolerance, its end lines untouched
+TEST(SimplifyTest, ReducesDenseProfile) {
+    SegmentStore segments;
+    segments.addLine(-10.0, 0.0, 0.0, 0.0);
+    constexpr int steps = 1000;
+    for (int i = 0; i < steps; i++) {
+        const double a0 = M_PI * i / steps;
+        const double a1 = M_PI * (i + 1) / steps;
+        // Half circle of radius 5 from (0, 0) to (10, 0)
+        segments.addLine(5.0 - 5.0 * std::cos(a0), 5.0 * std::sin(a0), 5.0 - 5.0 * std::cos(a1), 5.0 * std::sin(a1));
+    }
+    segments.addArc(10.0, 0.0, 20.0, 0.0, 0.5);
+
+    const SimplifyResult result = simplifySegments(segments, 0.01);
+    EXPECT_EQ(result.segmentsBefore, steps + 2);
+    EXPECT_LT(result.segments.size(), 40);
+    EXPECT_EQ(result.removed(), result.segmentsBefore - result.segments.size());
+
+    size_t arcs = 0;
+    for (size_t i = 0; i < result.segments.size(); i++) {
+        if (result.segments.kinds[i] == SegmentKind::Arc) {
+            arcs++;
+            continue;
+        }
+        // Every remaining vertex lies on the circle or on the straight lead-in
+        for (const Point& p : {result.segments.startPoint(i), result.segments.endPoint(i)}) {
+            const double radius = std::hypot(p.x - 5.0, p.y);
+            EXPECT_TRUE(std::abs(radius - 5.0) < 1e-9 || (p.y == 0.0 && p.x <= 0.0));
+        }
+    }
+    EXPECT_EQ(arcs, 1);
+}
+
+// Test branch vertices survive simplification
+TEST(SimplifyTest, KeepsBranchVertices) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 5.0, 0.0);
+    segments.addLine(5.0, 0.0, 10.0, 0.0);
+    segments.addLine(5.0, 0.0, 5.0, 5.0);
+
+    const SimplifyResult result = simplifySegments(segments, 0.1);
+    EXPECT_EQ(result.segments.size(), 3);
+}
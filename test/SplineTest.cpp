@@ -0,0 +1,60 @@
+//
+// Unit tests for Spline class
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "Arc.h"
+#include "Line.h"
+#include "Spline.h"
+
+class SplineTest : public ::testing::Test {
+};
+
+// Test a clamped quadratic Bezier against its closed form
+TEST_F(SplineTest, EvaluateBezier) {
+    const Spline spline(2, {{0.0, 0.0}, {1.0, 2.0}, {2.0, 0.0}}, {0.0, 0.0, 0.0, 1.0, 1.0, 1.0});
+    EXPECT_EQ(spline.evaluate(0.0), Point(0.0, 0.0));
+    EXPECT_EQ(spline.evaluate(1.0), Point(2.0, 0.0));
+    const Point mid = spline.evaluate(0.5);
+    EXPECT_NEAR(mid.x, 1.0, 1e-12);
+    EXPECT_NEAR(mid.y, 1.0, 1e-12);
+}
+
+// Test a rational quadratic reproduces an exact quarter circle
+TEST_F(SplineTest, RationalCircle) {
+    const Spline spline(2, {{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}}, {0.0, 0.0, 0.0, 1.0, 1.0, 1.0}, {1.0, std::sqrt(0.5), 1.0});
+    for (double t = 0.0; t <= 1.0; t += 0.1) {
+        const Point p = spline.evaluate(t);
+        EXPECT_NEAR(std::hypot(p.x, p.y), 1.0, 1e-12);
+    }
+}
+
+// Test tessellation stays within tolerance and adapts to curvature
+TEST_F(SplineTest, AdaptiveTessellation) {
+    const Spline spline(2, {{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}}, {0.0, 0.0, 0.0, 1.0, 1.0, 1.0}, {1.0, std::sqrt(0.5), 1.0});
+    const Arc quarter = Arc::fromCenter(Point(0.0, 0.0), 1.0, 0.0, M_PI_2);
+
+    const std::vector<Point> coarse = spline.tessellate(0.01);
+    const std::vector<Point> fine = spline.tessellate(0.0001);
+    EXPECT_LT(coarse.size(), fine.size());
+    EXPECT_EQ(coarse.front(), Point(1.0, 0.0));
+    for (size_t i = 1; i < fine.size(); i++) {
+        const Point mid((fine[i - 1].x + fine[i].x) / 2.0, (fine[i - 1].y + fine[i].y) / 2.0);
+        EXPECT_LE(quarter.distance(mid), 0.0001 + 1e-12);
+    }
+}
+
+// Test straight splines collapse to a single chord per knot span
+TEST_F(SplineTest, StraightSpline) {
+    const Spline spline(3, {{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}, {4.0, 0.0}}, {0.0, 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0, 1.0});
+    EXPECT_EQ(spline.tessellate(0.001).size(), 3);
+}
+
+// Test mismatched knot vectors are rejected
+TEST_F(SplineTest, InvalidKnots) {
+    EXPECT_THROW(Spline(2, {{0.0, 0.0}, {1.0, 1.0}, {2.0, 0.0}}, {0.0, 0.0, 1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(Spline(2, {{0.0, 0.0}, {1.0, 1.0}, {2.0, 0.0}}, {0.0, 0.0, 0.0, 1.0, 1.0, 1.0}, {1.0}), std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+//
+// Unit tests for streamed toolpath moves
+//
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "Generator.h"
+#include "toolpath/ToolpathGenerator.h"
+#include "toolpath/ToolpathOptimizer.h"
+
+namespace {
+Generator<int> countTo(const int limit, int* produced) {
+    for (int i = 1; i <= limit; i++) {
+        *produced = i;
+        co_yield i;
+    }
+}
+
+Generator<int> failAfterOne() {
+    co_yield 1;
+    throw std::runtime_error("generator failed");
+}
+}
+
+// Test that values are only produced when the consumer asks for them
+TEST(TMoveStreamTest, GeneratorIsLazy) {
+    int produced = 0;
+    Generator<int> generator = countTo(3, &produced);
+    EXPECT_EQ(produced, 0);
+
+    std::vector<int> values;
+    for (const int value : generator) {
+        EXPECT_EQ(produced, value);
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+
+    // A default generator is empty
+    Generator<int> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+// Test that exceptions thrown by the coroutine reach the consumer
+TEST(TMoveStreamTest, GeneratorPropagatesExceptions) {
+    Generator<int> generator = failAfterOne();
+    auto it = generator.begin();
+    EXPECT_EQ(*it, 1);
+    EXPECT_THROW(++it, std::runtime_error);
+}
+
+// Test that a sequence streamed and collected again keeps its moves and states
+TEST(TMoveStreamTest, StreamRoundTrip) {
+    TToolpathSequence sequence;
+    sequence.addRapid(TPoint(30.0, 5.0), TPoint(22.0, 5.0), 1, 2000.0, 900.0);
+    sequence.addLine(TPoint(22.0, 5.0), TPoint(22.0, -10.0), 1, 120.0, 900.0);
+    sequence.addArc(TPoint(22.0, -10.0), TPoint(24.0, -12.0), TPoint(24.0, -10.0), true, 2, 120.0, 900.0);
+
+    TToolpathSequence collected;
+    collected.append(streamMoves(sequence));
+    ASSERT_EQ(collected.size(), sequence.size());
+    ASSERT_EQ(collected.states().size(), sequence.states().size());
+    for (size_t i = 0; i < sequence.size(); i++) {
+        EXPECT_EQ(collected[i].kind, sequence[i].kind);
+        EXPECT_DOUBLE_EQ(collected[i].end.z, sequence[i].end.z);
+        EXPECT_EQ(collected.stateAt(i), sequence.stateAt(i));
+    }
+}
+
+// Test that the streamed generator output matches the collected toolpath
+TEST(TMoveStreamTest, StreamMatchesGeneratedToolpath) {
+    OperationConfiguration operation;
+    operation.operationType = OperationType::Turning;
+    operation.outerDistance = 20.0;
+    operation.innerDistance = 10.0;
+    operation.stepover = 2.0;
+    const MachineConfig machineConfig;
+
+    const TToolpathSequence generated = ToolpathGenerator::generateToolpath(operation, machineConfig);
+    ASSERT_FALSE(generated.empty());
+
+    // The stream holds its own copies of the configurations
+    TMoveStream stream = ToolpathGenerator::streamToolpath(operation, machineConfig);
+    operation.stepover = 1.0;
+
+    size_t i = 0;
+    for (const auto& [move, state] : stream) {
+        ASSERT_LT(i, generated.size());
+        EXPECT_EQ(move.kind, generated[i].kind);
+        EXPECT_DOUBLE_EQ(move.start.x, generated[i].start.x);
+        EXPECT_DOUBLE_EQ(move.end.z, generated[i].end.z);
+        EXPECT_EQ(state, generated.stateAt(i));
+        i++;
+    }
+    EXPECT_EQ(i, generated.size());
+}
+
+// Test that the streaming optimizer matches the batch pass
+TEST(TMoveStreamTest, OptimizeMovesMatchesBatch) {
+    TToolpathSequence sequence;
+    sequence.addLine(TPoint(10.0, 0.0), TPoint(10.0, -5.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(10.0, -5.0), TPoint(10.0, -5.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(10.0, -5.0), TPoint(10.0, -12.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(10.0, -12.0), TPoint(12.0, -12.0), 1, 100.0, 800.0);
+
+    const ToolpathOptimizerResult batch = optimizeToolpath(sequence);
+    ToolpathOptimizerResult counts;
+    TToolpathSequence streamed;
+    streamed.append(optimizeMoves(streamMoves(sequence), {}, &counts));
+
+    ASSERT_EQ(streamed.size(), batch.sequence.size());
+    EXPECT_EQ(counts.zeroLengthRemoved, batch.zeroLengthRemoved);
+    EXPECT_EQ(counts.collinearMerged, batch.collinearMerged);
+    for (size_t i = 0; i < streamed.size(); i++) {
+        EXPECT_DOUBLE_EQ(streamed[i].start.z, batch.sequence[i].start.z);
+        EXPECT_DOUBLE_EQ(streamed[i].end.x, batch.sequence[i].end.x);
+    }
+}
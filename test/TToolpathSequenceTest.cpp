@@ -0,0 +1,106 @@
+//
+// Unit tests for the TToolpathSequence move buffer
+//
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "../src/model/toolpath/TToolpathSequence.h"
+
+class TToolpathSequenceTest : public ::testing::Test {
+protected:
+    TToolpathSequence sequence;
+
+    void SetUp() override {
+        sequence.addLine(TPoint(10.0, 0.0), TPoint(5.0, 0.0), 1, 200.0, 800.0);
+        sequence.addLine(TPoint(5.0, 0.0), TPoint(5.0, -20.0), 1, 200.0, 800.0);
+        sequence.addArc(TPoint(5.0, -20.0), TPoint(8.0, -23.0), TPoint(8.0, -20.0), true, 1, 100.0, 800.0);
+        sequence.addLine(TPoint(8.0, -23.0), TPoint(10.0, -23.0), 2, 100.0, 1200.0);
+    }
+};
+
+// Test that moves are stored in order with their geometry
+TEST_F(TToolpathSequenceTest, StoresMoves) {
+    ASSERT_EQ(sequence.size(), 4);
+    EXPECT_EQ(sequence[1].type, TToolpathType::Line);
+    EXPECT_DOUBLE_EQ(sequence[1].end.z, -20.0);
+    EXPECT_EQ(sequence[2].type, TToolpathType::Arc);
+    EXPECT_TRUE(sequence[2].clockwise);
+    EXPECT_DOUBLE_EQ(sequence[2].center.x, 8.0);
+}
+
+// Test that a state run only starts when tool, feed or spindle speed changes
+TEST_F(TToolpathSequenceTest, RunLengthEncodesState) {
+    ASSERT_EQ(sequence.states().size(), 3);
+    EXPECT_EQ(sequence.states()[0].firstMove, 0);
+    EXPECT_EQ(sequence.states()[1].firstMove, 2);
+    EXPECT_EQ(sequence.states()[2].firstMove, 3);
+
+    EXPECT_DOUBLE_EQ(sequence.stateAt(1).feedRate, 200.0);
+    EXPECT_DOUBLE_EQ(sequence.stateAt(2).feedRate, 100.0);
+    EXPECT_EQ(sequence.stateAt(3).toolNumber, 2);
+    EXPECT_DOUBLE_EQ(sequence.stateAt(3).rpm, 1200.0);
+}
+
+// Test that iteration pairs every move with the state it runs in
+TEST_F(TToolpathSequenceTest, IterationMatchesStateAt) {
+    size_t index = 0;
+    for (const auto [move, state] : sequence) {
+        EXPECT_EQ(&move, &sequence[index]);
+        EXPECT_EQ(state, sequence.stateAt(index));
+        index++;
+    }
+    EXPECT_EQ(index, sequence.size());
+}
+
+// Test that the JSON format round trips
+TEST_F(TToolpathSequenceTest, JsonRoundTrip) {
+    const nlohmann::json j = sequence;
+    ASSERT_EQ(j.size(), 4);
+    EXPECT_EQ(j[2]["type"], "Arc");
+    EXPECT_EQ(j[3]["toolNumber"], 2);
+
+    const TToolpathSequence restored = j.get<TToolpathSequence>();
+    ASSERT_EQ(restored.size(), sequence.size());
+    EXPECT_EQ(restored.states().size(), sequence.states().size());
+    EXPECT_TRUE(restored[2].clockwise);
+    EXPECT_DOUBLE_EQ(restored[3].end.x, 10.0);
+    EXPECT_DOUBLE_EQ(restored.stateAt(3).rpm, 1200.0);
+}
+
+// Test that move kinds and dwell durations survive serialization
+TEST_F(TToolpathSequenceTest, JsonKeepsMoveKinds) {
+    sequence.addRapid(TPoint(10.0, -23.0), TPoint(12.0, 2.0), 2, 100.0, 1200.0);
+    sequence.addDwell(TPoint(12.0, 2.0), 1.5, 2, 1200.0);
+    EXPECT_EQ(sequence.states().size(), 3);
+
+    const nlohmann::json j = sequence;
+    EXPECT_EQ(j[4]["kind"], "Rapid");
+    EXPECT_EQ(j[5]["kind"], "Dwell");
+
+    const TToolpathSequence restored = j.get<TToolpathSequence>();
+    ASSERT_EQ(restored.size(), 6);
+    EXPECT_EQ(restored[0].kind, TMoveKind::Feed);
+    EXPECT_EQ(restored[4].kind, TMoveKind::Rapid);
+    EXPECT_EQ(restored[5].kind, TMoveKind::Dwell);
+    EXPECT_DOUBLE_EQ(restored[5].duration, 1.5);
+}
+
+// Test that moves written before kinds existed load as feed moves
+TEST_F(TToolpathSequenceTest, JsonWithoutKindIsFeed) {
+    nlohmann::json j = sequence;
+    for (auto& item : j) {
+        item.erase("kind");
+    }
+    const TToolpathSequence restored = j.get<TToolpathSequence>();
+    ASSERT_EQ(restored.size(), 4);
+    EXPECT_EQ(restored[2].kind, TMoveKind::Feed);
+}
+
+// Test that clearing drops both moves and state
+TEST_F(TToolpathSequenceTest, Clear) {
+    sequence.clear();
+    EXPECT_TRUE(sequence.empty());
+    EXPECT_TRUE(sequence.states().empty());
+    EXPECT_TRUE(sequence.begin() == sequence.end());
+}
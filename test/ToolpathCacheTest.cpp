@@ -0,0 +1,149 @@
+//
+// Unit tests for the toolpath cache
+//
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+#include "toolpath/ToolpathCache.h"
+
+class ToolpathCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path directory;
+    OperationConfiguration operation;
+    MachineConfig machineConfig;
+
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path() /
+                    ("turnlab-toolpath-cache-test-" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(directory);
+
+        operation.operationType = OperationType::Turning;
+        operation.outerDistance = 20.0;
+        operation.innerDistance = 10.0;
+        operation.stepover = 2.0;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    static void expectEqual(const TToolpathSequence& actual, const TToolpathSequence& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        ASSERT_EQ(actual.states().size(), expected.states().size());
+        for (size_t i = 0; i < actual.size(); i++) {
+            EXPECT_EQ(actual[i].kind, expected[i].kind);
+            EXPECT_DOUBLE_EQ(actual[i].start.x, expected[i].start.x);
+            EXPECT_DOUBLE_EQ(actual[i].end.z, expected[i].end.z);
+            EXPECT_EQ(actual.stateAt(i), expected.stateAt(i));
+        }
+    }
+};
+
+// Test the key follows the operation and the machine settings the generators use
+TEST_F(ToolpathCacheTest, KeyCoversInputs) {
+    const uint64_t base = ToolpathCache::key(operation, machineConfig);
+    EXPECT_EQ(ToolpathCache::key(operation, machineConfig), base);
+
+    OperationConfiguration changedOperation = operation;
+    changedOperation.stepover = 2.5;
+    EXPECT_NE(ToolpathCache::key(changedOperation, machineConfig), base);
+
+    MachineConfig changedMachine = machineConfig;
+    changedMachine.rapidFeedRate = 5000.0;
+    EXPECT_NE(ToolpathCache::key(operation, changedMachine), base);
+
+    // Limits are not read by the generators
+    changedMachine = machineConfig;
+    changedMachine.maxSpindleSpeed = 6000.0;
+    EXPECT_EQ(ToolpathCache::key(operation, changedMachine), base);
+}
+
+// Test the binary format round trip
+TEST_F(ToolpathCacheTest, BinaryRoundTrip) {
+    TToolpathSequence toolpath;
+    toolpath.addRapid(TPoint(30.0, 5.0), TPoint(22.0, 5.0), 1, 2000.0, 900.0);
+    toolpath.addLine(TPoint(22.0, 5.0), TPoint(22.0, -10.0), 1, 120.0, 900.0);
+    toolpath.addArc(TPoint(22.0, -10.0), TPoint(24.0, -12.0), TPoint(24.0, -10.0), true, 1, 120.0, 900.0);
+    toolpath.addDwell(TPoint(24.0, -12.0), 0.5, 2, 900.0);
+
+    std::stringstream stream;
+    writeToolpath(stream, toolpath);
+    const TToolpathSequence restored = readToolpath(stream);
+    expectEqual(restored, toolpath);
+    EXPECT_TRUE(restored[2].clockwise);
+    EXPECT_DOUBLE_EQ(restored[3].duration, 0.5);
+}
+
+// Test invalid data is rejected
+TEST_F(ToolpathCacheTest, RejectsInvalidData) {
+    std::stringstream garbage("not a toolpath at all");
+    EXPECT_THROW(readToolpath(garbage), std::runtime_error);
+
+    TToolpathSequence toolpath;
+    toolpath.addLine(TPoint(1.0, 0.0), TPoint(0.0, 0.0));
+    std::stringstream stream;
+    writeToolpath(stream, toolpath);
+    std::string data = stream.str();
+    data.pop_back();
+    std::stringstream truncated(data);
+    EXPECT_THROW(readToolpath(truncated), std::runtime_error);
+}
+
+// Test repeated generation is served from memory
+TEST_F(ToolpathCacheTest, GenerateMemoizes) {
+    ToolpathCache cache;
+    const TToolpathSequence first = cache.generate(operation, machineConfig);
+    ASSERT_FALSE(first.empty());
+    EXPECT_EQ(cache.getMisses(), 1);
+
+    expectEqual(cache.generate(operation, machineConfig), first);
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(cache.size(), 1);
+
+    operation.stepover = 1.0;
+    EXPECT_GT(cache.generate(operation, machineConfig).size(), first.size());
+    EXPECT_EQ(cache.getMisses(), 2);
+}
+
+// Test the least recently used entry is dropped first
+TEST_F(ToolpathCacheTest, EvictsLeastRecentlyUsed) {
+    ToolpathCache cache(2);
+    TToolpathSequence toolpath;
+    toolpath.addLine(TPoint(1.0, 0.0), TPoint(0.0, 0.0));
+    cache.insert(1, toolpath);
+    cache.insert(2, toolpath);
+    ASSERT_TRUE(cache.find(1).has_value());
+    cache.insert(3, toolpath);
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.find(1).has_value());
+    EXPECT_FALSE(cache.find(2).has_value());
+    EXPECT_TRUE(cache.find(3).has_value());
+}
+
+// Test toolpaths survive in the directory across cache instances
+TEST_F(ToolpathCacheTest, DiskCache) {
+    const TToolpathSequence generated = ToolpathCache(4, directory).generate(operation, machineConfig);
+
+    ToolpathCache reopened(4, directory);
+    const std::optional<TToolpathSequence> loaded = reopened.find(ToolpathCache::key(operation, machineConfig));
+    ASSERT_TRUE(loaded.has_value());
+    expectEqual(*loaded, generated);
+    EXPECT_EQ(reopened.getHits(), 1);
+}
+
+// Test a corrupt entry counts as a miss and is removed
+TEST_F(ToolpathCacheTest, CorruptEntryIsAMiss) {
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path path = directory / "0000000000000001.tltp";
+    std::ofstream(path) << "garbage";
+
+    ToolpathCache cache(4, directory);
+    EXPECT_FALSE(cache.find(1).has_value());
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_EQ(cache.getMisses(), 1);
+}
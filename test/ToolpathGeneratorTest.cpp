@@ -0,0 +1,67 @@
+//
+// Unit tests for the toolpath generators
+//
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "toolpath/ToolpathGenerator.h"
+#include "toolpath/ToolpathPasses.h"
+
+// Test that pass positions step into the stock against the axis direction
+TEST(ToolpathGeneratorTest, PassPositions) {
+    std::vector<double> positions(3);
+    passPositions<AxisDirection::Positive>(20.0, 2.5, positions);
+    EXPECT_EQ(positions, (std::vector<double>{17.5, 15.0, 12.5}));
+
+    passPositions<AxisDirection::Negative>(20.0, 2.5, positions);
+    EXPECT_EQ(positions, (std::vector<double>{22.5, 25.0, 27.5}));
+
+    EXPECT_EQ(passCount(10.0, 3.0), 4);
+    EXPECT_EQ(passCount(-10.0, 2.5), 4);
+    EXPECT_EQ(passCount(0.0, 2.5), 1);
+}
+
+// Test the distance ladder built from the operation offsets
+TEST(ToolpathGeneratorTest, DistanceLadder) {
+    OperationConfiguration operation;
+    operation.outerDistance = 20.0;
+    operation.innerDistance = 10.0;
+    operation.feedDistance = 1.0;
+    operation.retractDistance = 2.0;
+    operation.clearanceDistance = 4.0;
+
+    const DistanceLadder distances = distanceLadder(operation);
+    EXPECT_DOUBLE_EQ(distances.clearance, 27.0);
+    EXPECT_DOUBLE_EQ(distances.retract, 23.0);
+    EXPECT_DOUBLE_EQ(distances.feed, 21.0);
+    EXPECT_DOUBLE_EQ(distances.outer, 20.0);
+    EXPECT_DOUBLE_EQ(distances.inner, 10.0);
+}
+
+// Test that every axis direction combination dispatches to a generator stepping the right way
+TEST(ToolpathGeneratorTest, DispatchesOnAxisDirections) {
+    OperationConfiguration operation;
+    operation.operationType = OperationType::Turning;
+    operation.outerDistance = 20.0;
+    operation.innerDistance = 10.0;
+    operation.stepover = 2.5;
+
+    for (const AxisDirection z : {AxisDirection::Positive, AxisDirection::Negative}) {
+        for (const AxisDirection x : {AxisDirection::Positive, AxisDirection::Negative}) {
+            MachineConfig machineConfig;
+            machineConfig.zAxisDirection = z;
+            machineConfig.xAxisDirection = x;
+
+            const TToolpathSequence toolpath = ToolpathGenerator::generateToolpath(operation, machineConfig);
+            std::vector<double> cuts;
+            for (const TMove& move : toolpath.moves()) {
+                if (move.kind == TMoveKind::Plunge) {
+                    cuts.push_back(move.end.x);
+                }
+            }
+            const double step = x == AxisDirection::Positive ? -2.5 : 2.5;
+            EXPECT_EQ(cuts, (std::vector<double>{20.0 + step, 20.0 + 2 * step, 20.0 + 3 * step, 10.0}));
+        }
+    }
+}
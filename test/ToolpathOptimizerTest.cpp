@@ -0,0 +1,83 @@
+//
+// Unit tests for the toolpath optimizer
+//
+
+#include <gtest/gtest.h>
+
+#include "toolpath/ToolpathOptimizer.h"
+
+// Test that consecutive collinear lines with the same state become one line
+TEST(ToolpathOptimizerTest, MergesCollinearLines) {
+    TToolpathSequence sequence;
+    sequence.addLine(TPoint(10.0, 0.0), TPoint(10.0, -5.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(10.0, -5.0), TPoint(10.0, -12.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(10.0, -12.0), TPoint(10.0, -20.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(10.0, -20.0), TPoint(12.0, -20.0), 1, 100.0, 800.0);
+
+    const ToolpathOptimizerResult result = optimizeToolpath(sequence);
+    ASSERT_EQ(result.sequence.size(), 2);
+    EXPECT_EQ(result.collinearMerged, 2);
+    EXPECT_EQ(result.removed(), 2);
+    EXPECT_DOUBLE_EQ(result.sequence[0].start.z, 0.0);
+    EXPECT_DOUBLE_EQ(result.sequence[0].end.z, -20.0);
+    EXPECT_DOUBLE_EQ(result.sequence[1].end.x, 12.0);
+}
+
+// Test that lines differing in kind, feed or direction are not merged
+TEST(ToolpathOptimizerTest, KeepsDifferentMoves) {
+    TToolpathSequence sequence;
+    sequence.addLine(TPoint(10.0, 0.0), TPoint(8.0, 0.0), 1, 1000.0, 800.0, TMoveKind::Rapid);
+    sequence.addLine(TPoint(8.0, 0.0), TPoint(6.0, 0.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(6.0, 0.0), TPoint(5.0, 0.0), 1, 50.0, 800.0);
+    sequence.addLine(TPoint(5.0, 0.0), TPoint(7.0, 0.0), 1, 50.0, 800.0);
+
+    const ToolpathOptimizerResult result = optimizeToolpath(sequence);
+    EXPECT_EQ(result.sequence.size(), 4);
+    EXPECT_EQ(result.removed(), 0);
+}
+
+// Test that zero-length lines are dropped while dwells and arcs stay
+TEST(ToolpathOptimizerTest, DropsZeroLengthLines) {
+    TToolpathSequence sequence;
+    sequence.addLine(TPoint(10.0, 0.0), TPoint(10.0, 0.0), 1, 100.0, 800.0);
+    sequence.addLine(TPoint(10.0, 0.0), TPoint(5.0, 0.0), 1, 100.0, 800.0);
+    sequence.addDwell(TPoint(5.0, 0.0), 0.5, 1, 800.0);
+    sequence.addLine(TPoint(5.0, 0.0), TPoint(5.0, 0.0), 1, 100.0, 800.0);
+    sequence.addArc(TPoint(5.0, 0.0), TPoint(7.0, -2.0), TPoint(7.0, 0.0), true, 1, 100.0, 800.0);
+
+    const ToolpathOptimizerResult result = optimizeToolpath(sequence);
+    ASSERT_EQ(result.sequence.size(), 3);
+    EXPECT_EQ(result.zeroLengthRemoved, 2);
+    EXPECT_EQ(result.sequence[1].kind, TMoveKind::Dwell);
+    EXPECT_EQ(result.sequence[2].type, TToolpathType::Arc);
+}
+
+// Test that a slowly curving run of lines is not merged past the tolerance
+TEST(ToolpathOptimizerTest, RespectsTolerance) {
+    TToolpathSequence sequence;
+    sequence.addLine(TPoint(0.0, 0.0), TPoint(0.0, 10.0));
+    sequence.addLine(TPoint(0.0, 10.0), TPoint(0.005, 20.0));
+    sequence.addLine(TPoint(0.005, 20.0), TPoint(0.02, 30.0));
+
+    EXPECT_EQ(optimizeToolpath(sequence, {0.1}).sequence.size(), 1);
+
+    const ToolpathOptimizerResult strict = optimizeToolpath(sequence, {0.001});
+    EXPECT_EQ(strict.sequence.size(), 3);
+    EXPECT_EQ(strict.removed(), 0);
+}
+
+// Test that a long run of short collinear lines collapses into a single line
+TEST(ToolpathOptimizerTest, MergesLongRuns) {
+    constexpr size_t lines = 100000;
+    TToolpathSequence sequence;
+    sequence.reserve(lines);
+    for (size_t i = 0; i < lines; i++) {
+        sequence.addLine(TPoint(10.0, -0.01 * static_cast<double>(i)), TPoint(10.0, -0.01 * static_cast<double>(i + 1)));
+    }
+
+    const ToolpathOptimizerResult result = optimizeToolpath(sequence);
+    ASSERT_EQ(result.sequence.size(), 1);
+    EXPECT_EQ(result.collinearMerged, lines - 1);
+    EXPECT_DOUBLE_EQ(result.sequence[0].start.z, 0.0);
+    EXPECT_NEAR(result.sequence[0].end.z, -0.01 * lines, 1e-9);
+}
@@ -0,0 +1,102 @@
+//
+// Unit tests for chaining segments into profiles
+//
+
+#include <gtest/gtest.h>
+
+#include "SegmentStore.h"
+#include "Topology.h"
+
+class TopologyTest : public ::testing::Test {
+protected:
+    // Checks that consecutive elements of a chain share their endpoints
+    static void expectConnected(const Topology& topology, const Chain& chain, const SegmentStore& segments) {
+        ASSERT_EQ(chain.vertices.size(), chain.elements.size() + 1);
+        for (size_t i = 0; i < chain.elements.size(); i++) {
+            const Point start = topology.start(chain.elements[i], segments);
+            const Point end = topology.end(chain.elements[i], segments);
+            EXPECT_NEAR(start.x, topology.vertices[chain.vertices[i]].x, 1e-6);
+            EXPECT_NEAR(start.y, topology.vertices[chain.vertices[i]].y, 1e-6);
+            EXPECT_NEAR(end.x, topology.vertices[chain.vertices[i + 1]].x, 1e-6);
+            EXPECT_NEAR(end.y, topology.vertices[chain.vertices[i + 1]].y, 1e-6);
+        }
+    }
+};
+
+// Test that an unordered, partly reversed open profile is chained end to end
+TEST_F(TopologyTest, OpenChain) {
+    SegmentStore segments;
+    segments.addLine(10.0, 5.0, 20.0, 5.0);
+    segments.addLine(0.0, 0.0, 0.0, 5.0);
+    segments.addLine(10.0, 5.0, 0.0, 5.0);
+    segments.addLine(20.0, 5.0, 20.0, 0.0);
+
+    const Topology topology = buildTopology(segments);
+    ASSERT_EQ(topology.chains.size(), 1);
+    const Chain& chain = topology.chains[0];
+    EXPECT_FALSE(chain.closed);
+    ASSERT_EQ(chain.elements.size(), 4);
+    expectConnected(topology, chain, segments);
+    EXPECT_TRUE(topology.gaps.empty());
+    EXPECT_TRUE(topology.junctions.empty());
+}
+
+// Test that a loop is reported as a closed chain
+TEST_F(TopologyTest, ClosedChain) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 10.0, 0.0);
+    segments.addLine(10.0, 10.0, 10.0, 0.0);
+    segments.addLine(0.0, 10.0, 0.0, 0.0);
+    segments.addLine(10.0, 10.0, 0.0, 10.0 + 1e-9);
+
+    const Topology topology = buildTopology(segments);
+    ASSERT_EQ(topology.chains.size(), 1);
+    EXPECT_TRUE(topology.chains[0].closed);
+    EXPECT_EQ(topology.chains[0].vertices.front(), topology.chains[0].vertices.back());
+    expectConnected(topology, topology.chains[0], segments);
+}
+
+// Test that small gaps between chains are reported
+TEST_F(TopologyTest, Gaps) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 10.0, 0.0);
+    segments.addLine(10.05, 0.0, 20.0, 0.0);
+    segments.addLine(50.0, 0.0, 60.0, 0.0);
+
+    const Topology topology = buildTopology(segments, TopologyOptions{.tolerance = 1e-6, .gapDistance = 0.1});
+    EXPECT_EQ(topology.chains.size(), 3);
+    ASSERT_EQ(topology.gaps.size(), 1);
+    EXPECT_NEAR(topology.gaps[0].distance, 0.05, 1e-9);
+}
+
+// Test branch vertices and segments ending on another segment's interior
+TEST_F(TopologyTest, TJunctions) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 10.0, 0.0);
+    segments.addLine(5.0, 0.0, 5.0, 5.0);
+    segments.addLine(10.0, 0.0, 10.0, 5.0);
+    segments.addLine(10.0, 0.0, 15.0, 0.0);
+
+    const Topology topology = buildTopology(segments);
+    ASSERT_EQ(topology.junctions.size(), 2);
+    EXPECT_EQ(topology.junctions[0].segment, TJunction::NO_SEGMENT);
+    EXPECT_EQ(topology.vertices[topology.junctions[0].vertex], Point(10.0, 0.0));
+    EXPECT_EQ(topology.junctions[1].segment, 0);
+    EXPECT_EQ(topology.vertices[topology.junctions[1].vertex], Point(5.0, 0.0));
+}
+
+// Test chaining a selection reports the original segment indices
+TEST_F(TopologyTest, Selection) {
+    SegmentStore segments;
+    segments.addLine(0.0, 0.0, 1.0, 0.0);
+    segments.addLine(5.0, 5.0, 6.0, 6.0);
+    segments.addLine(1.0, 0.0, 2.0, 0.0);
+    segments.addLine(3.0, 3.0, 3.0, 3.0);
+
+    const Topology topology = buildTopology(segments, std::vector<size_t>{2, 0, 3});
+    ASSERT_EQ(topology.chains.size(), 1);
+    ASSERT_EQ(topology.chains[0].elements.size(), 2);
+    EXPECT_EQ(topology.chains[0].elements[0].segment + topology.chains[0].elements[1].segment, 2);
+    ASSERT_EQ(topology.degenerateSegments.size(), 1);
+    EXPECT_EQ(topology.degenerateSegments[0], 3);
+}
@@ -0,0 +1,104 @@
+//
+// Unit tests for Transform composition and TransformStack
+//
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "Geometry.h"
+#include "Point.h"
+#include "Transform.h"
+#include "TransformKernel.h"
+#include "TransformStack.h"
+
+class TransformStackTest : public ::testing::Test {
+protected:
+    static void expectPointNear(const Point& actual, const Point& expected) {
+        EXPECT_NEAR(actual.x, expected.x, 1e-12);
+        EXPECT_NEAR(actual.y, expected.y, 1e-12);
+    }
+};
+
+// Test that composition matches applying transformations one after another
+TEST_F(TransformStackTest, CompositionMatchesSequentialApply) {
+    const std::vector<Transform> transformations = {
+        Transform::rotate(M_PI_2),
+        Transform::translate(3.0, -1.0),
+        Transform::mirrorX(),
+        Transform::scale(25.4, 25.4)
+    };
+    Point p(1.5, 2.0);
+
+    TransformStack stack;
+    for (const auto& t : transformations) {
+        stack.push(t);
+    }
+
+    expectPointNear(stack.composed().apply(p), p.transform(transformations));
+    EXPECT_EQ(stack.size(), 4);
+}
+
+// Test inverse of a general affine transform
+TEST_F(TransformStackTest, Inverse) {
+    const Transform t = Transform::translate(2.0, 5.0) * Transform::rotate(0.3) * Transform::scale(2.0, 0.5);
+    const Point p(-4.0, 7.0);
+    expectPointNear(t.inverse().apply(t.apply(p)), p);
+    expectPointNear(t.apply(t.inverse().apply(p)), p);
+}
+
+// Test that a singular transform cannot be inverted
+TEST_F(TransformStackTest, SingularInverseThrows) {
+    EXPECT_THROW(Transform::scale(0.0, 1.0).inverse(), std::domain_error);
+}
+
+// Test that undo reverts the most recent transformation
+TEST_F(TransformStackTest, Undo) {
+    TransformStack stack;
+    const Point p(1.0, 2.0);
+    stack.push(Transform::translate(1.0, 1.0));
+    stack.push(Transform::rotate(M_PI_2));
+
+    EXPECT_TRUE(stack.undo());
+    expectPointNear(stack.composed().apply(p), Point(2.0, 3.0));
+    EXPECT_TRUE(stack.undo());
+    expectPointNear(stack.composed().apply(p), p);
+    EXPECT_FALSE(stack.undo());
+    EXPECT_TRUE(stack.empty());
+}
+
+// Test that Geometry applies the composed transform to every endpoint
+TEST_F(TransformStackTest, GeometryTransform) {
+    Geometry geometry;
+    geometry.segments.addLine(0.0, 0.0, 10.0, 0.0);
+
+    TransformStack stack;
+    stack.push(Transform::rotate(M_PI_2));
+    stack.push(Transform::translate(0.0, 5.0));
+
+    const Geometry transformed = geometry.transform(stack.composed());
+    expectPointNear(transformed.segments[0].start(), Point(0.0, 5.0));
+    expectPointNear(transformed.segments[0].end(), Point(0.0, 15.0));
+    expectPointNear(geometry.segments[0].end(), Point(10.0, 0.0));
+}
+
+// Test that the batch kernel matches the scalar reference, including the remainder loop
+TEST_F(TransformStackTest, BatchKernelMatchesScalar) {
+    const Transform t = Transform::translate(-3.0, 12.5) * Transform::rotate(0.7) * Transform::scale(25.4, 25.4);
+    for (size_t count : {0u, 1u, 3u, 4u, 7u, 1001u}) {
+        std::vector<double> xs(count), ys(count);
+        for (size_t i = 0; i < count; i++) {
+            xs[i] = 0.1 * static_cast<double>(i);
+            ys[i] = -0.3 * static_cast<double>(i) + 1.0;
+        }
+        std::vector<double> refXs = xs, refYs = ys;
+
+        transformPoints(t, xs.data(), ys.data(), count);
+        transformPointsScalar(t, refXs.data(), refYs.data(), count);
+
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(xs[i], refXs[i]);
+            EXPECT_EQ(ys[i], refYs[i]);
+            expectPointNear(Point(xs[i], ys[i]), t.apply(Point(0.1 * static_cast<double>(i), -0.3 * static_cast<double>(i) + 1.0)));
+        }
+    }
+}